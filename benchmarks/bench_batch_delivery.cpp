@@ -0,0 +1,134 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "../src/market_data.h"
+#include "../src/strategy.h"
+
+// Compares end-to-end feed -> strategy throughput for different consumer batch
+// sizes. A producer thread publishes ticks in chunks while the consumer drains
+// them with getNextBatch and hands them to dispatchTicks, once without a
+// registry and once through a shared indicator registry as the trading loop
+// does, for a stream where every tick is subscribed and one where one in four is.
+
+class BenchFeed : public DataFeed {
+public:
+    void subscribe(const std::string&) override {}
+    void start() override { running = true; }
+    void stop() override {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        running = false;
+        cv.notify_all();
+    }
+};
+
+// Cheap strategy so the measurement is dominated by delivery overhead
+class CountingStrategy : public Strategy {
+public:
+    int64_t ticks = 0;
+    int64_t volume = 0;
+    
+    CountingStrategy() : Strategy("Counting", 0.0) {}
+    void onMarketData(const MarketData& data) override {
+        ++ticks;
+        volume += data.volume;
+    }
+    void onOrderFilled(const Order&) override {}
+    void onTimer(TimerId) override {}
+};
+
+// Reads two shared moving averages on every tick of its symbol
+class IndicatorStrategy : public Strategy {
+private:
+    std::string symbol;
+    IndicatorHandle fast, slow;
+    
+public:
+    int64_t above = 0;
+    
+    IndicatorStrategy(const std::string& sym, IndicatorRegistry& registry)
+        : Strategy("Indicator", 0.0), symbol(sym),
+          fast(registry.subscribe(sym, IndicatorType::SMA, 5)),
+          slow(registry.subscribe(sym, IndicatorType::SMA, 20)) {}
+    void onMarketData(const MarketData& data) override {
+        if (data.symbol == symbol && slow.ready() && fast.compare(slow) > 0) ++above;
+    }
+    void onOrderFilled(const Order&) override {}
+    void onTimer(TimerId) override {}
+};
+
+double runDelivery(const std::vector<MarketData>& source, size_t tickCount, size_t batchSize,
+                   IndicatorRegistry* registry, Strategy* const* strategies, size_t strategyCount) {
+    BenchFeed feed;
+    std::vector<MarketData> batch(batchSize);
+    feed.start();
+    
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread producer([&]() {
+        for (size_t sent = 0; sent < tickCount; sent += source.size()) {
+            feed.addBatch(source.data(), std::min(source.size(), tickCount - sent));
+        }
+    });
+    
+    size_t received = 0;
+    while (received < tickCount) {
+        size_t count = feed.getNextBatch(batch.data(), batch.size());
+        dispatchTicks(registry, strategies, strategyCount, batch.data(), count);
+        received += count;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    producer.join();
+    feed.stop();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+void report(size_t batchSize, size_t tickCount, double secs) {
+    std::cout << "Batch " << std::setw(5) << batchSize << ": "
+              << std::fixed << std::setprecision(2) << tickCount / secs / 1e6 << " M ticks/s, "
+              << std::setprecision(1) << secs * 1e9 / tickCount << " ns/tick" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t tickCount = argc > 1 ? std::stoul(argv[1]) : 2000000;
+    const size_t producerChunk = 64;
+    const std::vector<size_t> batchSizes = {1, 4, 16, 64, 256, 1024};
+    
+    std::vector<MarketData> source;
+    std::vector<MarketData> mixedSource;
+    const char* others[] = {"MSFT", "GOOG", "AMZN"};
+    source.reserve(producerChunk);
+    mixedSource.reserve(producerChunk);
+    for (size_t i = 0; i < producerChunk; i++) {
+        double price = 150.0 + (i % 10) * 0.01;
+        source.emplace_back("AAPL", price - 0.01, price + 0.01, price, 100 + static_cast<int64_t>(i));
+        mixedSource.emplace_back(i % 4 == 0 ? "AAPL" : others[i % 4 - 1],
+                                 price - 0.01, price + 0.01, price, 100 + static_cast<int64_t>(i));
+    }
+    
+    std::cout << "Ticks per run: " << tickCount << " (producer chunk " << producerChunk << ")" << std::endl;
+    std::cout << "No registry:" << std::endl;
+    for (size_t batchSize : batchSizes) {
+        CountingStrategy strategy;
+        Strategy* strategies[] = {&strategy};
+        report(batchSize, tickCount, runDelivery(source, tickCount, batchSize, nullptr, strategies, 1));
+    }
+    
+    std::cout << "Shared registry, every tick subscribed:" << std::endl;
+    for (size_t batchSize : batchSizes) {
+        IndicatorRegistry registry;
+        IndicatorStrategy strategy("AAPL", registry);
+        Strategy* strategies[] = {&strategy};
+        report(batchSize, tickCount, runDelivery(source, tickCount, batchSize, &registry, strategies, 1));
+    }
+    
+    std::cout << "Shared registry, one tick in four subscribed:" << std::endl;
+    for (size_t batchSize : batchSizes) {
+        IndicatorRegistry registry;
+        IndicatorStrategy strategy("AAPL", registry);
+        CountingStrategy counter;
+        Strategy* strategies[] = {&strategy, &counter};
+        report(batchSize, tickCount, runDelivery(mixedSource, tickCount, batchSize, &registry, strategies, 2));
+    }
+    
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "../src/order_gateway.h"
+
+// Measures what an order costs the submitting strategy thread once sends go
+// through OrderGateway, and the end-to-end rate at which the gateway gets
+// orders to the local broker and their fills back.
+// Usage: BenchOrderGateway [orders per thread] [producer threads]
+namespace {
+
+void reportLatency(const std::string& label, std::vector<int64_t>& samples) {
+    std::sort(samples.begin(), samples.end());
+    double total = 0;
+    for (int64_t s : samples) total += static_cast<double>(s);
+    std::cout << label << ": mean " << std::fixed << std::setprecision(1) << total / samples.size()
+              << " ns, p50 " << samples[samples.size() / 2]
+              << " ns, p99 " << samples[samples.size() * 99 / 100]
+              << " ns, p99.9 " << samples[samples.size() * 999 / 1000] << " ns" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int ordersPerThread = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    const int threadCount = argc > 2 ? std::stoi(argv[2]) : 2;
+    using Clock = std::chrono::steady_clock;
+    
+    // Per-call cost on the strategy thread, timed one call at a time
+    {
+        BrokerSimulator broker;
+        broker.start();
+        OrderManager orderManager;
+        OrderGateway gateway(orderManager, broker.port());
+        gateway.start();
+        orderManager.setGateway(&gateway);
+        
+        const int samples = 200000;
+        std::vector<int64_t> sendNs, submitNs;
+        sendNs.reserve(samples);
+        submitNs.reserve(samples);
+        Order order(0, "AAPL", OrderType::BUY, 100, 150.0);
+        for (int i = 0; i < samples; i++) {
+            order.orderId = 1000000000 + i;
+            auto t0 = Clock::now();
+            gateway.send(order);
+            auto t1 = Clock::now();
+            sendNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (i % 64 == 0) gateway.waitForCompletion(std::chrono::seconds(10)); // Keep the queue from filling
+        }
+        for (int i = 0; i < samples; i++) {
+            auto t0 = Clock::now();
+            orderManager.submitOrder("AAPL", OrderType::BUY, 100, Price(15000));
+            auto t1 = Clock::now();
+            submitNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (i % 64 == 0) gateway.waitForCompletion(std::chrono::seconds(10));
+        }
+        gateway.waitForCompletion(std::chrono::seconds(10));
+        reportLatency("OrderGateway::send        ", sendNs);
+        reportLatency("OrderManager::submitOrder ", submitNs);
+        gateway.stop();
+        broker.stop();
+    }
+    
+    // Sustained throughput: producers submit flat out, timed until the last fill
+    for (int run = 0; run < 3; run++) {
+        BrokerSimulator broker;
+        broker.start();
+        OrderManager orderManager(1 << 20); // Room for everything the queue and sockets hold open
+        OrderGateway gateway(orderManager, broker.port());
+        gateway.start();
+        orderManager.setGateway(&gateway);
+        
+        auto t0 = Clock::now();
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threadCount; t++) {
+            producers.emplace_back([&]() {
+                for (int i = 0; i < ordersPerThread; i++) {
+                    orderManager.submitOrder("AAPL", i % 2 ? OrderType::SELL : OrderType::BUY, 100, Price(15000 + i % 16));
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        auto submitted = Clock::now();
+        bool complete = gateway.waitForCompletion(std::chrono::seconds(60));
+        auto t1 = Clock::now();
+        
+        double total = static_cast<double>(ordersPerThread) * threadCount;
+        double submitSecs = std::chrono::duration<double>(submitted - t0).count();
+        double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "Run " << run << ": " << static_cast<uint64_t>(total) << " orders from " << threadCount
+                  << " threads, submitted at " << std::fixed << std::setprecision(2) << total / submitSecs / 1e6
+                  << " M/s, filled at " << total / secs / 1e6 << " M/s"
+                  << (complete ? "" : " (incomplete)") << std::endl;
+        gateway.stop();
+        broker.stop();
+    }
+    return 0;
+}
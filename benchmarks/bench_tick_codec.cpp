@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../src/tick_codec.h"
+
+// Measures compression ratio and decode throughput of the tick codec.
+// Throughput is reported in raw field bytes per second (three prices, two
+// 64-bit integers and a 4-byte symbol per tick), which is what replay would
+// otherwise have to read from disk uncompressed.
+int main(int argc, char* argv[]) {
+    size_t tickCount = argc > 1 ? std::stoul(argv[1]) : 5000000;
+    const char* symbols[] = {"AAPL", "GOOGL", "MSFT", "AMZN", "NVDA"};
+    
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> step(-3, 3);
+    std::uniform_int_distribution<int> gap(1, 2000);
+    std::vector<int64_t> lastTicks(5, 15000);
+    
+    std::vector<MarketData> ticks;
+    ticks.reserve(tickCount);
+    auto time = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < tickCount; i++) {
+        size_t s = i % 5;
+        lastTicks[s] += step(rng);
+        double price = lastTicks[s] / 100.0;
+        MarketData tick(symbols[s], price - 0.01, price + 0.01, price, 1000000 + static_cast<int64_t>(i));
+        time += std::chrono::microseconds(gap(rng));
+        tick.timestamp = time;
+        ticks.push_back(tick);
+    }
+    
+    auto t0 = std::chrono::steady_clock::now();
+    TickEncoder encoder;
+    for (const auto& tick : ticks) {
+        encoder.append(tick);
+    }
+    encoder.flush();
+    auto t1 = std::chrono::steady_clock::now();
+    
+    TickDecoder decoder(encoder.buffer());
+    size_t rawBytes = tickCount * (sizeof(double) * 3 + sizeof(int64_t) * 2 + 4);
+    
+    std::cout << "Ticks:            " << tickCount << std::endl;
+    std::cout << "Blocks:           " << decoder.blockCount() << std::endl;
+    std::cout << "Raw field bytes:  " << rawBytes << std::endl;
+    std::cout << "Encoded bytes:    " << encoder.buffer().size() << " ("
+              << std::fixed << std::setprecision(2)
+              << static_cast<double>(encoder.buffer().size()) / tickCount << " B/tick, "
+              << static_cast<double>(rawBytes) / encoder.buffer().size() << "x)" << std::endl;
+    std::cout << "Encode:           "
+              << tickCount / std::chrono::duration<double>(t1 - t0).count() / 1e6 << " M ticks/s" << std::endl;
+    
+    // Streaming replay: one block at a time into a reused buffer
+    {
+        std::vector<MarketData> block;
+        int64_t checksum = 0;
+        auto d0 = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < decoder.blockCount(); b++) {
+            decoder.decodeBlock(b, block);
+            checksum += block.back().volume;
+        }
+        auto d1 = std::chrono::steady_clock::now();
+        double secs = std::chrono::duration<double>(d1 - d0).count();
+        std::cout << "Replay by block:  "
+                  << tickCount / secs / 1e6 << " M ticks/s, "
+                  << rawBytes / secs / 1e9 << " GB/s raw (checksum " << checksum << ")" << std::endl;
+    }
+    
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        std::vector<MarketData> decoded;
+        decoded.reserve(tickCount);
+        auto d0 = std::chrono::steady_clock::now();
+        decoder.decodeAll(decoded, threads);
+        auto d1 = std::chrono::steady_clock::now();
+        double secs = std::chrono::duration<double>(d1 - d0).count();
+        std::cout << "Decode " << threads << " thread(s): "
+                  << tickCount / secs / 1e6 << " M ticks/s, "
+                  << rawBytes / secs / 1e9 << " GB/s raw" << std::endl;
+    }
+    
+    return 0;
+}
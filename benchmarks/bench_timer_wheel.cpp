@@ -0,0 +1,64 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include "../src/timer_service.h"
+#include "../src/strategy.h"
+
+// Measures schedule, cancel and expiry cost with a large number of
+// outstanding timers, e.g. one cancel-after timer per working order.
+
+class NullStrategy : public Strategy {
+public:
+    int64_t fired = 0;
+    NullStrategy() : Strategy("Null", 0.0) {}
+    void onMarketData(const MarketData&) override {}
+    void onOrderFilled(const Order&) override {}
+    void onTimer(TimerId) override { ++fired; }
+};
+
+int main(int argc, char* argv[]) {
+    size_t timerCount = argc > 1 ? std::stoul(argv[1]) : 500000;
+    using namespace std::chrono;
+    
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> delayMs(1, 600000); // Up to 10 minutes
+    std::vector<milliseconds> delays(timerCount);
+    for (auto& delay : delays) {
+        delay = milliseconds(delayMs(rng));
+    }
+    
+    TimerService timers(milliseconds(1), timerCount);
+    NullStrategy strategy;
+    auto start = TimerService::Clock::now();
+    timers.start(start);
+    
+    std::vector<TimerId> ids(timerCount);
+    auto t0 = steady_clock::now();
+    for (size_t i = 0; i < timerCount; i++) {
+        ids[i] = timers.schedule(&strategy, delays[i]);
+    }
+    auto t1 = steady_clock::now();
+    for (size_t i = 0; i < timerCount; i += 2) {
+        timers.cancel(ids[i]);
+    }
+    auto t2 = steady_clock::now();
+    // Advance in 1ms steps like a busy live loop would
+    size_t steps = 0;
+    for (auto now = start; timers.pending() > 0; now += milliseconds(1)) {
+        timers.advanceTo(now);
+        ++steps;
+    }
+    auto t3 = steady_clock::now();
+    
+    auto perOp = [](steady_clock::duration d, size_t n) {
+        return duration<double, std::nano>(d).count() / static_cast<double>(n);
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Timers:       " << timerCount << std::endl;
+    std::cout << "Schedule:     " << perOp(t1 - t0, timerCount) << " ns/timer" << std::endl;
+    std::cout << "Cancel:       " << perOp(t2 - t1, timerCount / 2) << " ns/timer" << std::endl;
+    std::cout << "Expire:       " << perOp(t3 - t2, static_cast<size_t>(strategy.fired)) << " ns/timer ("
+              << strategy.fired << " fired over " << steps << " 1ms steps)" << std::endl;
+    return 0;
+}
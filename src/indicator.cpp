@@ -0,0 +1,155 @@
+#include "indicator.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Indicator implementation
+int Indicator::compare(const Indicator& other) const {
+    // Cross-multiplied in 128 bits: tick sums times periods cannot overflow
+    __int128 lhs = static_cast<__int128>(numerator) * other.denominator;
+    __int128 rhs = static_cast<__int128>(other.numerator) * denominator;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// SimpleMovingAverage implementation
+SimpleMovingAverage::SimpleMovingAverage(int p, int64_t value, const std::deque<Price>& prices)
+    : period(p), tickValue(value) {
+    count = static_cast<int>(std::min(prices.size(), static_cast<size_t>(period)));
+    for (auto it = prices.end() - count; it != prices.end(); ++it) {
+        sum += it->ticks();
+    }
+    publish();
+}
+
+void SimpleMovingAverage::update(const std::deque<Price>& prices) {
+    sum += prices.back().ticks();
+    if (count == period) {
+        // The window keeps at least period + 1 prices, so the outgoing one is still there
+        sum -= prices[prices.size() - 1 - period].ticks();
+    } else {
+        ++count;
+    }
+    publish();
+}
+
+void SimpleMovingAverage::publish() {
+    if (count == period) {
+        current = static_cast<double>(sum * tickValue) / (static_cast<double>(period) * Money::MICROS_PER_UNIT);
+        numerator = sum;
+        denominator = period;
+        isReady = true;
+    }
+}
+
+// IndicatorHandle implementation
+IndicatorHandle::IndicatorHandle(const IndicatorHandle& other)
+    : registry(other.registry), indicator(other.indicator), symbolSequence(other.symbolSequence), key(other.key) {
+    if (registry) {
+        registry->acquire(key);
+    }
+}
+
+IndicatorHandle::IndicatorHandle(IndicatorHandle&& other) noexcept
+    : registry(other.registry), indicator(other.indicator), symbolSequence(other.symbolSequence),
+      key(std::move(other.key)) {
+    other.registry = nullptr;
+    other.indicator = nullptr;
+    other.symbolSequence = nullptr;
+}
+
+IndicatorHandle& IndicatorHandle::operator=(IndicatorHandle other) noexcept {
+    std::swap(registry, other.registry);
+    std::swap(indicator, other.indicator);
+    std::swap(symbolSequence, other.symbolSequence);
+    std::swap(key, other.key);
+    return *this;
+}
+
+void IndicatorHandle::reset() {
+    if (registry) {
+        registry->release(key);
+        registry = nullptr;
+        indicator = nullptr;
+        symbolSequence = nullptr;
+    }
+}
+
+// IndicatorRegistry implementation
+IndicatorHandle IndicatorRegistry::subscribe(const std::string& symbol, IndicatorType type, int period) {
+    if (period <= 0) {
+        throw std::invalid_argument("Indicator period must be positive");
+    }
+
+    IndicatorKey key{symbol, type, period};
+    SymbolSeries& s = series[symbol];
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        std::unique_ptr<Indicator> indicator;
+        switch (type) {
+            case IndicatorType::SMA:
+                indicator = std::make_unique<SimpleMovingAverage>(period, TickSizes::tickValue(symbol), s.prices);
+                break;
+        }
+        s.capacity = std::max(s.capacity, static_cast<size_t>(indicator->lookback()) + 1);
+        s.indicators.push_back(indicator.get());
+        it = entries.emplace(key, Entry{std::move(indicator), 0}).first;
+    }
+
+    ++it->second.refCount;
+    return IndicatorHandle(this, it->second.indicator.get(), &s.sequence, key);
+}
+
+void IndicatorRegistry::acquire(const IndicatorKey& key) {
+    ++entries.at(key).refCount;
+}
+
+void IndicatorRegistry::release(const IndicatorKey& key) {
+    auto it = entries.find(key);
+    if (it == entries.end() || --it->second.refCount > 0) return;
+
+    auto seriesIt = series.find(key.symbol);
+    SymbolSeries& s = seriesIt->second;
+    s.indicators.erase(std::find(s.indicators.begin(), s.indicators.end(), it->second.indicator.get()));
+    entries.erase(it);
+
+    if (s.indicators.empty()) {
+        series.erase(seriesIt);
+        return;
+    }
+
+    // Shrink the shared window to what the remaining indicators need
+    s.capacity = 0;
+    for (const Indicator* indicator : s.indicators) {
+        s.capacity = std::max(s.capacity, static_cast<size_t>(indicator->lookback()) + 1);
+    }
+    while (s.prices.size() > s.capacity) {
+        s.prices.pop_front();
+    }
+}
+
+void IndicatorRegistry::onMarketData(const MarketData& data) {
+    if (SymbolSeries* s = find(data.symbol)) {
+        advance(*s, data);
+    }
+}
+
+IndicatorRegistry::SymbolSeries* IndicatorRegistry::find(const std::string& symbol) {
+    auto it = series.find(symbol);
+    return it != series.end() ? &it->second : nullptr;
+}
+
+void IndicatorRegistry::advance(SymbolSeries& s, const MarketData& data) {
+    s.prices.push_back(data.last);
+    ++s.sequence;
+    for (Indicator* indicator : s.indicators) {
+        indicator->update(s.prices);
+    }
+    while (s.prices.size() > s.capacity) {
+        s.prices.pop_front();
+    }
+}
+
+
+size_t IndicatorRegistry::windowSize(const std::string& symbol) const {
+    auto it = series.find(symbol);
+    return it != series.end() ? it->second.prices.size() : 0;
+}
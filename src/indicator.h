@@ -0,0 +1,146 @@
+#ifndef INDICATOR_H
+#define INDICATOR_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "market_data.h"
+
+enum class IndicatorType { SMA };
+
+struct IndicatorKey {
+    std::string symbol;
+    IndicatorType type;
+    int period;
+
+    bool operator==(const IndicatorKey& other) const {
+        return type == other.type && period == other.period && symbol == other.symbol;
+    }
+};
+
+struct IndicatorKeyHash {
+    size_t operator()(const IndicatorKey& key) const {
+        size_t h = std::hash<std::string>()(key.symbol);
+        h ^= std::hash<int>()(static_cast<int>(key.type)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<int>()(key.period) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+// A series computed from a symbol's shared price window. The window passed to
+// update() already contains the newest price at the back. Values are reported
+// as doubles in price units for display; the exact value is kept in ticks as
+// numerator / denominator for comparisons.
+class Indicator {
+protected:
+    double current = 0.0;
+    int64_t numerator = 0;
+    int64_t denominator = 1; // Always positive
+    bool isReady = false;
+
+public:
+    virtual ~Indicator() = default;
+    virtual void update(const std::deque<Price>& prices) = 0;
+    virtual int lookback() const = 0; // Prices needed in the window besides the newest
+
+    double value() const { return current; }
+    bool ready() const { return isReady; }
+    // Exact three-way comparison (-1, 0, 1) against an indicator of the same symbol
+    int compare(const Indicator& other) const;
+};
+
+class SimpleMovingAverage : public Indicator {
+private:
+    int period;
+    int64_t tickValue;
+    int64_t sum = 0; // In ticks, so the running sum never drifts
+    int count = 0;
+
+    void publish();
+
+public:
+    // Seeds the running sum from whatever history the window already holds
+    SimpleMovingAverage(int period, int64_t tickValue, const std::deque<Price>& prices);
+    void update(const std::deque<Price>& prices) override;
+    int lookback() const override { return period; }
+};
+
+class IndicatorRegistry;
+
+// Read-only, reference-counted view of a registry indicator. Copies share the
+// indicator; when the last handle goes away the registry tears it down.
+// Handles must not outlive the registry that issued them.
+class IndicatorHandle {
+private:
+    IndicatorRegistry* registry = nullptr;
+    const Indicator* indicator = nullptr;
+    const uint64_t* symbolSequence = nullptr;
+    IndicatorKey key;
+
+    friend class IndicatorRegistry;
+    IndicatorHandle(IndicatorRegistry* reg, const Indicator* ind, const uint64_t* seq, const IndicatorKey& k)
+        : registry(reg), indicator(ind), symbolSequence(seq), key(k) {}
+    void reset();
+
+public:
+    IndicatorHandle() = default;
+    IndicatorHandle(const IndicatorHandle& other);
+    IndicatorHandle(IndicatorHandle&& other) noexcept;
+    IndicatorHandle& operator=(IndicatorHandle other) noexcept;
+    ~IndicatorHandle() { reset(); }
+
+    bool valid() const { return indicator != nullptr; }
+    double value() const { return indicator->value(); }
+    bool ready() const { return indicator->ready(); }
+    int compare(const IndicatorHandle& other) const { return indicator->compare(*other.indicator); }
+    // Ticks applied to this indicator's symbol so far; goes up by exactly one
+    // per tick, so a subscriber can tell whether it has seen every update
+    uint64_t sequence() const { return *symbolSequence; }
+};
+
+// Computes each unique (symbol, type, parameters) series once per tick and
+// shares it between all subscribers. Strategies subscribe up front; the
+// trading loop calls onMarketData() before dispatching the tick to them.
+// Not thread-safe: subscribe, update and release from the trading thread.
+class IndicatorRegistry {
+public:
+    // Shared price window and indicators of one subscribed symbol
+    struct SymbolSeries {
+        std::deque<Price> prices;
+        size_t capacity = 0;
+        std::vector<Indicator*> indicators;
+        uint64_t sequence = 0; // Ticks applied so far
+    };
+
+private:
+    struct Entry {
+        std::unique_ptr<Indicator> indicator;
+        int refCount;
+    };
+
+    std::unordered_map<IndicatorKey, Entry, IndicatorKeyHash> entries;
+    std::unordered_map<std::string, SymbolSeries> series;
+
+    friend class IndicatorHandle;
+    void acquire(const IndicatorKey& key);
+    void release(const IndicatorKey& key);
+
+public:
+    IndicatorRegistry() = default;
+    IndicatorRegistry(const IndicatorRegistry&) = delete;
+    IndicatorRegistry& operator=(const IndicatorRegistry&) = delete;
+
+    IndicatorHandle subscribe(const std::string& symbol, IndicatorType type, int period);
+    void onMarketData(const MarketData& data);
+    // Split form of onMarketData for callers that act between the lookup and
+    // the update: find() returns null when nothing is subscribed to symbol
+    SymbolSeries* find(const std::string& symbol);
+    void advance(SymbolSeries& s, const MarketData& data);
+
+    size_t indicatorCount() const { return entries.size(); }
+    size_t windowSize(const std::string& symbol) const;
+};
+
+#endif // INDICATOR_H
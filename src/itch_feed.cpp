@@ -0,0 +1,549 @@
+#include "itch_feed.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+template<typename T>
+T read(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+std::chrono::high_resolution_clock::time_point fromNanos(uint64_t ns) {
+    return std::chrono::high_resolution_clock::time_point(
+        std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+constexpr int64_t MAX_LADDER_LEVELS = int64_t(1) << 24;
+constexpr size_t MAX_RESTING_ORDERS = 2000; // Per symbol in generated captures
+
+} // namespace
+
+// itch::Encoder implementation
+namespace itch {
+
+template<typename T>
+void Encoder::put(T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void Encoder::header(char type, size_t size, uint64_t timestampNs, uint16_t locate) {
+    put<uint16_t>(static_cast<uint16_t>(size));
+    put<uint8_t>(static_cast<uint8_t>(type));
+    put<uint64_t>(timestampNs);
+    put<uint16_t>(locate);
+}
+
+void Encoder::directory(uint64_t ts, uint16_t locate, const std::string& symbol) {
+    header('R', DIRECTORY_SIZE, ts, locate);
+    char name[8];
+    std::memset(name, ' ', sizeof(name));
+    std::memcpy(name, symbol.data(), std::min(symbol.size(), sizeof(name)));
+    out.insert(out.end(), name, name + sizeof(name));
+}
+
+void Encoder::addOrder(uint64_t ts, uint16_t locate, uint64_t ref, char side, uint32_t shares, int64_t price) {
+    header('A', ADD_SIZE, ts, locate);
+    put<uint64_t>(ref);
+    put<uint8_t>(static_cast<uint8_t>(side));
+    put<uint32_t>(shares);
+    put<int64_t>(price);
+}
+
+void Encoder::modifyOrder(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares, int64_t price) {
+    header('U', MODIFY_SIZE, ts, locate);
+    put<uint64_t>(ref);
+    put<uint32_t>(shares);
+    put<int64_t>(price);
+}
+
+void Encoder::cancelShares(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares) {
+    header('X', CANCEL_SIZE, ts, locate);
+    put<uint64_t>(ref);
+    put<uint32_t>(shares);
+}
+
+void Encoder::deleteOrder(uint64_t ts, uint16_t locate, uint64_t ref) {
+    header('D', DELETE_SIZE, ts, locate);
+    put<uint64_t>(ref);
+}
+
+void Encoder::executeOrder(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares) {
+    header('E', EXECUTE_SIZE, ts, locate);
+    put<uint64_t>(ref);
+    put<uint32_t>(shares);
+}
+
+void Encoder::trade(uint64_t ts, uint16_t locate, int64_t price, uint32_t shares) {
+    header('T', TRADE_SIZE, ts, locate);
+    put<int64_t>(price);
+    put<uint32_t>(shares);
+}
+
+void Encoder::quote(uint64_t ts, uint16_t locate, int64_t bid, uint32_t bidSize, int64_t ask, uint32_t askSize) {
+    header('Q', QUOTE_SIZE, ts, locate);
+    put<int64_t>(bid);
+    put<uint32_t>(bidSize);
+    put<int64_t>(ask);
+    put<uint32_t>(askSize);
+}
+
+std::vector<uint8_t> generateCapture(const std::vector<std::string>& symbols, size_t messageCount, uint64_t seed) {
+    struct LiveOrder {
+        uint64_t ref;
+        char side;
+        uint32_t shares;
+        int64_t price;
+    };
+
+    std::vector<uint8_t> capture;
+    capture.reserve(messageCount * 30);
+    Encoder encoder(capture);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    uint64_t ts = 1700000000000000000ULL;
+    uint64_t nextRef = 1;
+    std::vector<int64_t> mids;
+    std::vector<std::vector<LiveOrder>> live(symbols.size());
+    for (size_t i = 0; i < symbols.size() && i < messageCount; ++i) {
+        encoder.directory(ts, static_cast<uint16_t>(i), symbols[i]);
+        mids.push_back(10000 + static_cast<int64_t>(i) * 2500);
+    }
+
+    size_t quoteDriven = symbols.size() > 1 ? symbols.size() - 1 : symbols.size();
+    for (size_t n = symbols.size(); n < messageCount; ++n) {
+        ts += 100 + rng() % 900;
+        uint16_t s = static_cast<uint16_t>(rng() % symbols.size());
+        if (rng() % 64 == 0) {
+            mids[s] += (rng() % 2) ? 1 : -1;
+        }
+
+        if (s == quoteDriven) {
+            if (uniform(rng) < 0.8) {
+                int64_t half = 1 + static_cast<int64_t>(rng() % 3);
+                encoder.quote(ts, s, mids[s] - half, 100 + rng() % 900, mids[s] + half, 100 + rng() % 900);
+            } else {
+                encoder.trade(ts, s, mids[s], 100);
+            }
+            continue;
+        }
+
+        std::vector<LiveOrder>& orders = live[s];
+        double r = uniform(rng);
+        // Books stay near a steady size, as real ones do over a session
+        if (orders.empty() || (r < 0.45 && orders.size() < MAX_RESTING_ORDERS)) {
+            char side = (rng() % 2) ? 'B' : 'S';
+            int64_t offset = 1 + static_cast<int64_t>(rng() % 5);
+            LiveOrder order{nextRef++, side, static_cast<uint32_t>(100 * (1 + rng() % 10)),
+                            side == 'B' ? mids[s] - offset : mids[s] + offset};
+            encoder.addOrder(ts, s, order.ref, order.side, order.shares, order.price);
+            orders.push_back(order);
+            continue;
+        }
+
+        size_t idx = rng() % orders.size();
+        LiveOrder& order = orders[idx];
+        r = uniform(rng);
+        if (r < 0.15) {
+            order.price += (order.side == 'B') ? -1 : 1;
+            order.shares = static_cast<uint32_t>(100 * (1 + rng() % 10));
+            encoder.modifyOrder(ts, s, order.ref, order.shares, order.price);
+        } else if (r < 0.30 && order.shares > 100) {
+            encoder.cancelShares(ts, s, order.ref, 100);
+            order.shares -= 100;
+        } else if (r < 0.70) {
+            encoder.deleteOrder(ts, s, order.ref);
+            order = orders.back();
+            orders.pop_back();
+        } else {
+            uint32_t shares = std::min<uint32_t>(order.shares, 100 * (1 + rng() % 5));
+            encoder.executeOrder(ts, s, order.ref, shares);
+            order.shares -= shares;
+            if (order.shares == 0) {
+                order = orders.back();
+                orders.pop_back();
+            }
+        }
+    }
+    return capture;
+}
+
+void writeCapture(const std::string& filename, const std::vector<uint8_t>& capture) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open capture file for writing: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(capture.data()), static_cast<std::streamsize>(capture.size()));
+}
+
+} // namespace itch
+
+// PriceLadder implementation
+int64_t PriceLadder::indexFor(int64_t ticks) {
+    if (levels.empty()) {
+        levels.assign(1024, 0);
+        base = ticks - 512;
+    }
+
+    int64_t index = ticks - base;
+    if (index < 0) {
+        // Grow downwards, keeping headroom so repeated new lows don't re-copy
+        int64_t shift = std::max<int64_t>(-index + 256, static_cast<int64_t>(levels.size()));
+        if (static_cast<int64_t>(levels.size()) + shift > MAX_LADDER_LEVELS) {
+            throw std::runtime_error("Price ladder range exceeded");
+        }
+        levels.insert(levels.begin(), static_cast<size_t>(shift), 0);
+        base -= shift;
+        if (best >= 0) best += shift;
+        index += shift;
+    } else if (index >= static_cast<int64_t>(levels.size())) {
+        int64_t newSize = std::max<int64_t>(index + 256, static_cast<int64_t>(levels.size()) * 2);
+        if (newSize > MAX_LADDER_LEVELS) {
+            throw std::runtime_error("Price ladder range exceeded");
+        }
+        levels.resize(static_cast<size_t>(newSize), 0);
+    }
+    return index;
+}
+
+void PriceLadder::add(int64_t ticks, int64_t qty) {
+    if (qty <= 0) return;
+    int64_t index = indexFor(ticks);
+    levels[index] += qty;
+    totalQty += qty;
+    if (best < 0 || (isBid ? index > best : index < best)) {
+        best = index;
+    }
+}
+
+void PriceLadder::remove(int64_t ticks, int64_t qty) {
+    int64_t index = ticks - base;
+    levels[index] -= qty;
+    totalQty -= qty;
+    if (index != best || levels[index] > 0) return;
+
+    if (totalQty == 0) {
+        best = -1;
+        return;
+    }
+    // Walk away from the touch to the next populated level
+    if (isBid) {
+        while (levels[best] == 0) --best;
+    } else {
+        while (levels[best] == 0) ++best;
+    }
+}
+
+// OrderTable implementation
+OrderTable::OrderTable(size_t initialCapacity) {
+    size_t capacity = 16;
+    shift = 60;
+    while (capacity < initialCapacity) {
+        capacity <<= 1;
+        --shift;
+    }
+    slots.assign(capacity, Entry{EMPTY, 0, 0, 0, false});
+    mask = capacity - 1;
+}
+
+void OrderTable::grow() {
+    std::vector<Entry> old(slots.size() * 2, Entry{EMPTY, 0, 0, 0, false});
+    old.swap(slots);
+    mask = slots.size() - 1;
+    --shift;
+    count = 0;
+    for (const Entry& entry : old) {
+        if (entry.ref != EMPTY) insert(entry);
+    }
+}
+
+void OrderTable::insert(const Entry& entry) {
+    if ((count + 1) * 2 > slots.size()) {
+        grow();
+    }
+    size_t i = home(entry.ref);
+    while (slots[i].ref != EMPTY && slots[i].ref != entry.ref) {
+        i = (i + 1) & mask;
+    }
+    if (slots[i].ref == EMPTY) ++count;
+    slots[i] = entry;
+}
+
+void OrderTable::erase(Entry* entry) {
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole unless that would move them before their home slot
+    size_t hole = static_cast<size_t>(entry - slots.data());
+    for (size_t i = (hole + 1) & mask; slots[i].ref != EMPTY; i = (i + 1) & mask) {
+        size_t h = home(slots[i].ref);
+        bool movable = (i > hole) ? (h <= hole || h > i) : (h <= hole && h > i);
+        if (movable) {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole].ref = EMPTY;
+    --count;
+}
+
+// ItchDecoder implementation
+ItchDecoder::Book* ItchDecoder::bookFor(uint16_t locate) {
+    if (locate >= books.size() || !books[locate].active) return nullptr;
+    return &books[locate];
+}
+
+void ItchDecoder::emitIfChanged(Book& book, uint64_t timestampNs, std::vector<MarketData>& out) {
+    // Held back until the symbol trades, so consumers never see a zero last price
+    if (book.last == Price()) return;
+    Price bid = book.quoteDriven ? book.quoteBid : book.bids.bestPrice();
+    Price ask = book.quoteDriven ? book.quoteAsk : book.asks.bestPrice();
+    if (bid == book.emittedBid && ask == book.emittedAsk) return;
+
+    book.emittedBid = bid;
+    book.emittedAsk = ask;
+    out.emplace_back(book.symbol, bid, ask, book.last, book.volume, fromNanos(timestampNs));
+}
+
+void ItchDecoder::handle(const uint8_t* msg, size_t size, std::vector<MarketData>& out) {
+    if (size < itch::HEADER_SIZE) {
+        throw std::runtime_error("ITCH message shorter than its header");
+    }
+    char type = static_cast<char>(msg[0]);
+    uint64_t ts = read<uint64_t>(msg + 1);
+    uint16_t locate = read<uint16_t>(msg + 9);
+    const uint8_t* body = msg + itch::HEADER_SIZE;
+
+    auto require = [size](size_t expected) {
+        if (size < expected) {
+            throw std::runtime_error("ITCH message truncated");
+        }
+    };
+
+    switch (type) {
+        case 'R': {
+            require(itch::DIRECTORY_SIZE);
+            if (locate >= books.size()) {
+                books.resize(static_cast<size_t>(locate) + 1);
+            }
+            const char* name = reinterpret_cast<const char*>(body);
+            size_t len = 8;
+            while (len > 0 && name[len - 1] == ' ') --len;
+            Book& book = books[locate];
+            book.symbol.assign(name, len);
+            book.active = subscriptions.empty() || subscriptions.count(book.symbol) > 0;
+            break;
+        }
+        case 'A': {
+            require(itch::ADD_SIZE);
+            Book* book = bookFor(locate);
+            if (!book) break;
+            uint64_t ref = read<uint64_t>(body);
+            bool isBid = body[8] == 'B';
+            uint32_t shares = read<uint32_t>(body + 9);
+            int64_t price = read<int64_t>(body + 13);
+            if (ref == OrderTable::EMPTY) {
+                throw std::runtime_error("ITCH order reference out of range");
+            }
+            if (OrderTable::Entry* existing = orders.find(ref)) {
+                // Reused reference: the old order no longer rests
+                Book& old = books[existing->locate];
+                (existing->isBid ? old.bids : old.asks).remove(existing->price, existing->shares);
+                orders.erase(existing);
+            }
+            if (shares > 0) {
+                orders.insert(OrderTable::Entry{ref, price, shares, locate, isBid});
+                (isBid ? book->bids : book->asks).add(price, shares);
+            }
+            emitIfChanged(*book, ts, out);
+            break;
+        }
+        case 'U': {
+            require(itch::MODIFY_SIZE);
+            OrderTable::Entry* order = orders.find(read<uint64_t>(body));
+            if (!order) break;
+            Book& book = books[order->locate];
+            PriceLadder& side = order->isBid ? book.bids : book.asks;
+            side.remove(order->price, order->shares);
+            order->shares = read<uint32_t>(body + 8);
+            order->price = read<int64_t>(body + 12);
+            side.add(order->price, order->shares);
+            if (order->shares == 0) orders.erase(order);
+            emitIfChanged(book, ts, out);
+            break;
+        }
+        case 'X':
+        case 'E': {
+            require(itch::CANCEL_SIZE);
+            OrderTable::Entry* order = orders.find(read<uint64_t>(body));
+            if (!order) break;
+            Book& book = books[order->locate];
+            uint32_t shares = std::min(read<uint32_t>(body + 8), order->shares);
+            (order->isBid ? book.bids : book.asks).remove(order->price, shares);
+            if (type == 'E') {
+                book.last = Price(order->price);
+                book.volume += shares;
+            }
+            order->shares -= shares;
+            if (order->shares == 0) orders.erase(order);
+            emitIfChanged(book, ts, out);
+            break;
+        }
+        case 'D': {
+            require(itch::DELETE_SIZE);
+            OrderTable::Entry* order = orders.find(read<uint64_t>(body));
+            if (!order) break;
+            Book& book = books[order->locate];
+            (order->isBid ? book.bids : book.asks).remove(order->price, order->shares);
+            orders.erase(order);
+            emitIfChanged(book, ts, out);
+            break;
+        }
+        case 'T': {
+            require(itch::TRADE_SIZE);
+            Book* book = bookFor(locate);
+            if (!book) break;
+            book->last = Price(read<int64_t>(body));
+            book->volume += read<uint32_t>(body + 8);
+            emitIfChanged(*book, ts, out); // Releases a book held for its first trade
+            break;
+        }
+        case 'Q': {
+            require(itch::QUOTE_SIZE);
+            Book* book = bookFor(locate);
+            if (!book) break;
+            book->quoteDriven = true;
+            book->quoteBid = Price(read<int64_t>(body));
+            book->quoteAsk = Price(read<int64_t>(body + 12));
+            emitIfChanged(*book, ts, out);
+            break;
+        }
+        default:
+            break; // Unknown message types are skipped
+    }
+}
+
+size_t ItchDecoder::decode(const uint8_t* data, size_t length, std::vector<MarketData>& out) {
+    size_t pos = 0;
+    while (length - pos >= sizeof(uint16_t)) {
+        size_t size = read<uint16_t>(data + pos);
+        if (length - pos - sizeof(uint16_t) < size) break; // Partial message
+        handle(data + pos + sizeof(uint16_t), size, out);
+        pos += sizeof(uint16_t) + size;
+        ++messageCount;
+    }
+    return pos;
+}
+
+// MappedFile implementation
+MappedFile::MappedFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open capture file: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat capture file: " + filename);
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map capture file: " + filename);
+        }
+        ::madvise(addr, length, MADV_SEQUENTIAL);
+        mapped = static_cast<const uint8_t*>(addr);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (mapped) {
+        ::munmap(const_cast<uint8_t*>(mapped), length);
+    }
+}
+
+// ItchFileFeed implementation
+ItchFileFeed::ItchFileFeed(const std::string& file, size_t maxQueuedTicks)
+    : filename(file), maxQueued(maxQueuedTicks) {}
+
+ItchFileFeed::~ItchFileFeed() {
+    stop();
+}
+
+void ItchFileFeed::subscribe(const std::string& symbol) {
+    decoder.subscribe(symbol);
+    std::cout << "Subscribed to: " << symbol << std::endl;
+}
+
+void ItchFileFeed::start() {
+    capture = std::make_unique<MappedFile>(filename);
+    running = true;
+    feedThread = std::thread([this]() { replay(); });
+}
+
+void ItchFileFeed::stop() {
+    {
+        // Under the lock like every other access to the flag; wakes consumers
+        std::lock_guard<std::mutex> lock(queueMutex);
+        running = false;
+        cv.notify_all();
+    }
+    if (feedThread.joinable()) {
+        feedThread.join();
+    }
+}
+
+void ItchFileFeed::waitForRoom() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!running || dataQueue.size() <= maxQueued) return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void ItchFileFeed::replay() {
+    const uint8_t* data = capture->data();
+    size_t size = capture->size();
+    std::vector<MarketData> ticks;
+    size_t pos = 0;
+
+    try {
+        while (pos < size && isRunning()) {
+            // A slice larger than the biggest frame always holds a full message
+            size_t slice = std::min<size_t>(size - pos, size_t(1) << 17);
+            size_t used = decoder.decode(data + pos, slice, ticks);
+            if (used == 0) break; // Truncated final message
+            pos += used;
+
+            if (!ticks.empty()) {
+                waitForRoom();
+                addBatch(ticks.data(), ticks.size());
+                ticks.clear();
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Feed error in " << filename << ": " << e.what() << std::endl;
+    }
+
+    // End of capture: wake consumers so they drain without waiting out a timeout
+    std::lock_guard<std::mutex> lock(queueMutex);
+    running = false;
+    cv.notify_all();
+}
@@ -0,0 +1,211 @@
+#ifndef ITCH_FEED_H
+#define ITCH_FEED_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <unordered_set>
+#include "market_data.h"
+
+// Binary market data protocol modelled on NASDAQ ITCH, little-endian.
+//
+// Every message is framed as a u16 length (bytes that follow) and a payload
+// that starts with a one-byte type, a u64 timestamp (ns since the epoch) and
+// a u16 locate code identifying the instrument. Prices are i64 ticks of the
+// instrument. Type-specific fields follow:
+//   'R' symbol directory  char[8] symbol (space padded)
+//   'A' add order         u64 ref, u8 side ('B'/'S'), u32 shares, i64 price
+//   'U' modify order      u64 ref, u32 shares, i64 price
+//   'X' cancel shares     u64 ref, u32 shares
+//   'D' delete order      u64 ref
+//   'E' order executed    u64 ref, u32 shares
+//   'T' trade             i64 price, u32 shares
+//   'Q' quote             i64 bid, u32 bid size, i64 ask, u32 ask size
+// Messages of unknown type are skipped using the length prefix.
+namespace itch {
+
+constexpr size_t HEADER_SIZE = 11; // type + timestamp + locate
+constexpr size_t DIRECTORY_SIZE = HEADER_SIZE + 8;
+constexpr size_t ADD_SIZE = HEADER_SIZE + 21;
+constexpr size_t MODIFY_SIZE = HEADER_SIZE + 20;
+constexpr size_t CANCEL_SIZE = HEADER_SIZE + 12;
+constexpr size_t DELETE_SIZE = HEADER_SIZE + 8;
+constexpr size_t EXECUTE_SIZE = HEADER_SIZE + 12;
+constexpr size_t TRADE_SIZE = HEADER_SIZE + 12;
+constexpr size_t QUOTE_SIZE = HEADER_SIZE + 24;
+
+// Appends framed messages to a byte buffer; used by the capture generator and tests.
+class Encoder {
+private:
+    std::vector<uint8_t>& out;
+
+    void header(char type, size_t size, uint64_t timestampNs, uint16_t locate);
+    template<typename T> void put(T value);
+
+public:
+    explicit Encoder(std::vector<uint8_t>& buffer) : out(buffer) {}
+
+    void directory(uint64_t ts, uint16_t locate, const std::string& symbol);
+    void addOrder(uint64_t ts, uint16_t locate, uint64_t ref, char side, uint32_t shares, int64_t price);
+    void modifyOrder(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares, int64_t price);
+    void cancelShares(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares);
+    void deleteOrder(uint64_t ts, uint16_t locate, uint64_t ref);
+    void executeOrder(uint64_t ts, uint16_t locate, uint64_t ref, uint32_t shares);
+    void trade(uint64_t ts, uint16_t locate, int64_t price, uint32_t shares);
+    void quote(uint64_t ts, uint16_t locate, int64_t bid, uint32_t bidSize, int64_t ask, uint32_t askSize);
+};
+
+// Writes a synthetic capture: a directory entry per symbol followed by random
+// order book activity. The last symbol is quote-driven (Q messages only).
+std::vector<uint8_t> generateCapture(const std::vector<std::string>& symbols, size_t messageCount,
+                                     uint64_t seed = 1);
+void writeCapture(const std::string& filename, const std::vector<uint8_t>& capture);
+
+} // namespace itch
+
+// Aggregate quantity per price for one side of a book, indexed directly by
+// tick offset so updates and best-price tracking are array operations.
+class PriceLadder {
+private:
+    std::vector<int64_t> levels;
+    int64_t base = 0;      // Tick price of levels[0]
+    int64_t best = -1;     // Index of the best non-empty level, -1 if empty
+    int64_t totalQty = 0;
+    bool isBid;
+
+    int64_t indexFor(int64_t ticks);
+
+public:
+    explicit PriceLadder(bool bidSide) : isBid(bidSide) {}
+
+    void add(int64_t ticks, int64_t qty);
+    void remove(int64_t ticks, int64_t qty);
+    bool empty() const { return totalQty == 0; }
+    Price bestPrice() const { return best < 0 ? Price() : Price(base + best); }
+    int64_t bestQty() const { return best < 0 ? 0 : levels[best]; }
+};
+
+// Resting orders keyed by reference number: an open-addressing hash table
+// with linear probing and backward-shift deletion. Memory follows the number
+// of live orders rather than the highest reference seen, so a full session's
+// worth of references can be replayed.
+class OrderTable {
+public:
+    struct Entry {
+        uint64_t ref;
+        int64_t price;
+        uint32_t shares;
+        uint16_t locate;
+        bool isBid;
+    };
+
+    static constexpr uint64_t EMPTY = ~uint64_t(0); // Reserved; never a valid reference
+
+private:
+    std::vector<Entry> slots;
+    size_t mask;
+    int shift;
+    size_t count = 0;
+
+    size_t home(uint64_t ref) const { return static_cast<size_t>((ref * 0x9E3779B97F4A7C15ULL) >> shift); }
+    void grow();
+
+public:
+    // Capacity is rounded up to a power of two and doubles at half load
+    explicit OrderTable(size_t initialCapacity = 1 << 12);
+
+    Entry* find(uint64_t ref) {
+        for (size_t i = home(ref);; i = (i + 1) & mask) {
+            if (slots[i].ref == ref) return &slots[i];
+            if (slots[i].ref == EMPTY) return nullptr;
+        }
+    }
+    // Adds the entry, replacing any entry with the same reference
+    void insert(const Entry& entry);
+    // Removes an entry returned by find(); invalidates other entry pointers
+    void erase(Entry* entry);
+    size_t size() const { return count; }
+};
+
+// Decodes the protocol above straight out of a receive or mapped buffer,
+// keeps top of book per instrument and emits a MarketData whenever an
+// instrument's best bid or ask price changes. Nothing is emitted for an
+// instrument until it has traded, so every tick carries a last price.
+class ItchDecoder {
+private:
+
+    struct Book {
+        std::string symbol;
+        bool active = false;       // Seen in the directory and subscribed
+        bool quoteDriven = false;  // BBO comes from Q messages, not orders
+        PriceLadder bids{true};
+        PriceLadder asks{false};
+        Price quoteBid, quoteAsk;
+        Price last;
+        int64_t volume = 0;
+        Price emittedBid, emittedAsk;
+    };
+
+    std::vector<Book> books;           // Indexed by locate code
+    OrderTable orders;                 // Live orders only
+    std::unordered_set<std::string> subscriptions;
+    uint64_t messageCount = 0;
+
+    Book* bookFor(uint16_t locate);
+    void handle(const uint8_t* msg, size_t size, std::vector<MarketData>& out);
+    void emitIfChanged(Book& book, uint64_t timestampNs, std::vector<MarketData>& out);
+
+public:
+    // Restricts emission to these symbols; with none, every symbol is decoded
+    void subscribe(const std::string& symbol) { subscriptions.insert(symbol); }
+
+    // Decodes every complete message in data, appending BBO changes to out.
+    // Returns the bytes consumed; a trailing partial message is left for the
+    // caller to resubmit with more data.
+    size_t decode(const uint8_t* data, size_t length, std::vector<MarketData>& out);
+
+    uint64_t messagesDecoded() const { return messageCount; }
+    size_t liveOrders() const { return orders.size(); }
+};
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+private:
+    const uint8_t* mapped = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return mapped; }
+    size_t size() const { return length; }
+};
+
+// Replays a captured binary feed file into the DataFeed queue.
+class ItchFileFeed : public DataFeed {
+private:
+    std::string filename;
+    std::unique_ptr<MappedFile> capture;
+    ItchDecoder decoder;
+    std::thread feedThread;
+    size_t maxQueued;
+
+    void replay();
+    void waitForRoom();
+
+public:
+    // Decoding pauses while more than maxQueued ticks wait in the queue
+    explicit ItchFileFeed(const std::string& file, size_t maxQueued = 1 << 16);
+    ~ItchFileFeed() override;
+
+    void subscribe(const std::string& symbol) override;
+    void start() override;
+    void stop() override;
+};
+
+#endif // ITCH_FEED_H
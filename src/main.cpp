@@ -2,12 +2,16 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <algorithm>
 #include "market_data.h"
 #include "strategy.h"
 #include "order_manager.h"
 #include "risk_manager.h"
 #include "portfolio.h"
 #include "config.h"
+#include "timer_service.h"
+#include "itch_feed.h"
 
 // Simple CSV Data Feed for demonstration
 class CSVDataFeed : public DataFeed {
@@ -50,16 +54,25 @@ public:
         running = true;
         feedThread = std::thread([this]() {
             for (const auto& data : historicalData) {
-                if (!running) break;
+                if (!isRunning()) break;
                 
                 addData(data);
                 std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Faster simulation
             }
+            
+            // Out of data: let the trading loop finish once the queue drains
+            std::lock_guard<std::mutex> lock(queueMutex);
+            running = false;
+            cv.notify_all();
         });
     }
     
     void stop() override {
-        running = false;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            running = false;
+            cv.notify_all();
+        }
         if (feedThread.joinable()) {
             feedThread.join();
         }
@@ -73,31 +86,90 @@ int main() {
         // Load configuration
         Config config;
         config.loadFromFile("config.txt");
+        TickSizes::loadFromConfig(config);
         
         // Initialize components
-        auto dataFeed = std::make_unique<CSVDataFeed>();
-        auto strategy = std::make_unique<MovingAverageCrossover>("AAPL", 5, 20, 100000.0);
+        // Replay a binary capture when one is configured, else the built-in sample data
+        std::string capturePath = config.get<std::string>("itch_capture", "");
+        std::unique_ptr<DataFeed> dataFeed;
+        if (!capturePath.empty()) {
+            dataFeed = std::make_unique<ItchFileFeed>(capturePath);
+        } else {
+            auto csvFeed = std::make_unique<CSVDataFeed>();
+            csvFeed->loadData();
+            dataFeed = std::move(csvFeed);
+        }
+        // Strategies share indicator series; dispatchTicks keeps the registry in step
+        IndicatorRegistry indicators;
+        auto strategy = std::make_unique<MovingAverageCrossover>("AAPL", 5, 20, 100000.0, indicators);
+        Strategy* strategies[] = {strategy.get()};
         auto orderManager = std::make_unique<OrderManager>();
         auto riskManager = std::make_unique<RiskManager>(10000.0, 5000.0);
         Portfolio portfolio(100000.0);
         
-        // Load sample data
-        dataFeed->loadData();
+        // Timers run on data time in backtests and on wall-clock time live
+        const bool liveMode = config.get<std::string>("mode", "backtest") == "live";
+        TimerService timers;
+        strategy->setTimerService(&timers);
+        
         dataFeed->subscribe("AAPL");
+        
+        // The wheel runs before any tick is delivered: from now when live,
+        // from the first tick's timestamp in backtests
+        if (liveMode) {
+            timers.start(std::chrono::high_resolution_clock::now());
+        }
         dataFeed->start();
+        if (!liveMode) {
+            auto firstTimestamp = std::chrono::high_resolution_clock::now(); // Kept if the feed is empty
+            while (!dataFeed->peekTimestamp(firstTimestamp) && dataFeed->isRunning()) {}
+            timers.start(firstTimestamp);
+        }
+        for (Strategy* s : strategies) {
+            s->onSessionStart();
+        }
         
         // Process market data - increased count to see the crossover
-        MarketData data;
-        int dataCount = 0;
+        const size_t maxDataPoints = 55;
+        std::vector<MarketData> batch(std::max<size_t>(1, config.get<size_t>("batch_size", 64)));
+        size_t dataCount = 0;
         std::cout << "\n=== Starting Market Data Processing ===" << std::endl;
         
-        while (dataFeed->getNextData(data) && dataCount < 55) { // Process more data points
-            std::cout << "Processing: " << data.symbol 
-                      << " Price: $" << std::fixed << std::setprecision(2) << data.last 
-                      << " Volume: " << data.volume << std::endl;
+        while (dataCount < maxDataPoints) { // Process more data points
+            // Live timers fire on every pass, so waiting for data is bounded by the next one due
+            auto maxWait = std::chrono::milliseconds(100);
+            if (liveMode) {
+                auto now = std::chrono::high_resolution_clock::now();
+                timers.advanceTo(now);
+                auto due = timers.nextDue();
+                if (due != std::chrono::high_resolution_clock::time_point::max()) {
+                    maxWait = std::min(maxWait, std::chrono::ceil<std::chrono::milliseconds>(
+                        std::max(due - now, std::chrono::high_resolution_clock::duration::zero())));
+                }
+            }
+            
+            size_t count = dataFeed->getNextBatch(batch.data(), std::min(batch.size(), maxDataPoints - dataCount),
+                                                  maxWait);
+            if (count == 0) {
+                // A quiet feed is not the end of the session; a finished one is
+                if (!dataFeed->isRunning()) break;
+                continue;
+            }
             
-            strategy->onMarketData(data);
-            ++dataCount;
+            for (size_t i = 0; i < count; ++i) {
+                const MarketData& data = batch[i];
+                std::cout << "Processing: " << data.symbol 
+                          << " Price: $" << std::fixed << std::setprecision(2) << data.last.toDouble(data.symbol) 
+                          << " Volume: " << data.volume << std::endl;
+            }
+            
+            if (liveMode) {
+                timers.advanceTo(std::chrono::high_resolution_clock::now());
+                dispatchTicks(&indicators, strategies, 1, batch.data(), count);
+            } else {
+                dispatchTicksOnDataTime(timers, &indicators, strategies, 1, batch.data(), count);
+            }
+            dataCount += count;
             
             // Small delay to see the output clearly
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -2,14 +2,21 @@
 
 // MarketData default constructor
 MarketData::MarketData()
-    : symbol(""), bid(0.0), ask(0.0), last(0.0), volume(0), 
+    : symbol(""), bid(), ask(), last(), volume(0), 
       timestamp(std::chrono::high_resolution_clock::now()) {}
 
 // MarketData parameterized constructor
-MarketData::MarketData(const std::string& sym, double b, double a, double l, int64_t v)
+MarketData::MarketData(const std::string& sym, Price b, Price a, Price l, int64_t v)
     : symbol(sym), bid(b), ask(a), last(l), volume(v), 
       timestamp(std::chrono::high_resolution_clock::now()) {}
 
+MarketData::MarketData(const std::string& sym, Price b, Price a, Price l, int64_t v,
+                       std::chrono::high_resolution_clock::time_point ts)
+    : symbol(sym), bid(b), ask(a), last(l), volume(v), timestamp(ts) {}
+
+MarketData::MarketData(const std::string& sym, double b, double a, double l, int64_t v)
+    : MarketData(sym, Price::fromDouble(sym, b), Price::fromDouble(sym, a), Price::fromDouble(sym, l), v) {}
+
 // DataFeed implementation
 void DataFeed::addData(const MarketData& data) {
     std::lock_guard<std::mutex> lock(queueMutex);
@@ -17,6 +24,14 @@ void DataFeed::addData(const MarketData& data) {
     cv.notify_one();
 }
 
+void DataFeed::addBatch(const MarketData* data, size_t count) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (size_t i = 0; i < count; ++i) {
+        dataQueue.push(data[i]);
+    }
+    cv.notify_one();
+}
+
 bool DataFeed::getNextData(MarketData& data) {
     std::unique_lock<std::mutex> lock(queueMutex);
     cv.wait_for(lock, std::chrono::milliseconds(100), [this] { return !dataQueue.empty() || !running; });
@@ -27,4 +42,30 @@ bool DataFeed::getNextData(MarketData& data) {
         return true;
     }
     return false;
+}
+
+size_t DataFeed::getNextBatch(MarketData* out, size_t maxCount, std::chrono::milliseconds maxWait) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    cv.wait_for(lock, maxWait, [this] { return !dataQueue.empty() || !running; });
+    
+    size_t count = 0;
+    while (count < maxCount && !dataQueue.empty()) {
+        out[count++] = std::move(dataQueue.front());
+        dataQueue.pop();
+    }
+    return count;
+}
+
+bool DataFeed::peekTimestamp(std::chrono::high_resolution_clock::time_point& timestamp,
+                             std::chrono::milliseconds maxWait) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    cv.wait_for(lock, maxWait, [this] { return !dataQueue.empty() || !running; });
+    if (dataQueue.empty()) return false;
+    timestamp = dataQueue.front().timestamp;
+    return true;
+}
+
+bool DataFeed::isRunning() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return running;
 }
\ No newline at end of file
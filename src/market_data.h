@@ -6,14 +6,19 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include "price.h"
 
 class MarketData {
 public:
     std::string symbol;
-    double bid, ask, last;
+    Price bid, ask, last;
     int64_t volume;
     std::chrono::high_resolution_clock::time_point timestamp;
     MarketData();
+    MarketData(const std::string& sym, Price b, Price a, Price l, int64_t v);
+    MarketData(const std::string& sym, Price b, Price a, Price l, int64_t v,
+               std::chrono::high_resolution_clock::time_point ts);
+    // Converts the prices using the symbol's tick size
     MarketData(const std::string& sym, double b, double a, double l, int64_t v);
 };
 
@@ -31,7 +36,20 @@ public:
     virtual void stop() = 0;
     
     void addData(const MarketData& data);
+    void addBatch(const MarketData* data, size_t count);
     bool getNextData(MarketData& data);
+    // Drains up to maxCount queued ticks into out under a single lock
+    // acquisition; waits up to maxWait when the queue is empty.
+    // Returns the number of ticks written.
+    size_t getNextBatch(MarketData* out, size_t maxCount,
+                        std::chrono::milliseconds maxWait = std::chrono::milliseconds(100));
+    // Timestamp of the next queued tick without removing it; waits up to
+    // maxWait for one. Returns false if none arrived.
+    bool peekTimestamp(std::chrono::high_resolution_clock::time_point& timestamp,
+                       std::chrono::milliseconds maxWait = std::chrono::milliseconds(100));
+    // False once the feed has been stopped or has run out of data; queued
+    // ticks may remain to be drained
+    bool isRunning();
 };
 
 #endif // MARKET_DATA_H
\ No newline at end of file
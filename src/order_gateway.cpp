@@ -0,0 +1,430 @@
+#include "order_gateway.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+template<typename T>
+T read(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template<typename T>
+uint8_t* write(uint8_t* p, T value) {
+    std::memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+}
+
+constexpr size_t MAX_BATCH = 512;        // Orders encoded per write
+constexpr int SPIN_LIMIT = 2000;         // Idle polls before the I/O thread parks
+constexpr int PARK_TIMEOUT_MS = 10;
+constexpr size_t RECEIVE_BUFFER = 1 << 16;
+
+std::string errorText(const std::string& what) {
+    return what + ": " + std::strerror(errno);
+}
+
+void setNoDelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+sockaddr_in loopback(uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+void appendReport(std::vector<uint8_t>& out, char type, uint32_t orderId, uint32_t quantity, int64_t price) {
+    size_t offset = out.size();
+    out.resize(offset + wire::LENGTH_SIZE + wire::REPORT_SIZE);
+    uint8_t* p = out.data() + offset;
+    p = write<uint16_t>(p, static_cast<uint16_t>(wire::REPORT_SIZE));
+    p = write<uint8_t>(p, static_cast<uint8_t>(type));
+    p = write<uint32_t>(p, orderId);
+    p = write<uint32_t>(p, quantity);
+    write<int64_t>(p, price);
+}
+
+} // namespace
+
+// OrderQueue implementation
+OrderQueue::OrderQueue(size_t capacity) {
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) size <<= 1;
+    cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = size - 1;
+}
+
+bool OrderQueue::tryPush(const OrderRequest& request) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // The cell is free for this position; claim it
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // Full: the consumer has not freed this cell yet
+        } else {
+            pos = tail.load(std::memory_order_relaxed); // Another producer claimed it
+        }
+    }
+    cell->request = request;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool OrderQueue::tryPop(OrderRequest& request) {
+    Cell& cell = cells[head & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1) return false;
+    request = cell.request;
+    cell.sequence.store(head + mask + 1, std::memory_order_release);
+    ++head;
+    return true;
+}
+
+bool OrderQueue::empty() const {
+    return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+}
+
+// OrderGateway implementation
+OrderGateway::OrderGateway(OrderManager& orderManager, uint16_t port, size_t queueCapacity)
+    : manager(orderManager), queue(queueCapacity), inbound(RECEIVE_BUFFER) {
+    socketFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socketFd < 0) {
+        throw std::runtime_error(errorText("Order gateway socket"));
+    }
+    sockaddr_in addr = loopback(port);
+    if (::connect(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::string message = errorText("Order gateway cannot connect to port " + std::to_string(port));
+        ::close(socketFd);
+        throw std::runtime_error(message);
+    }
+    setNoDelay(socketFd);
+    ::fcntl(socketFd, F_SETFL, ::fcntl(socketFd, F_GETFL) | O_NONBLOCK);
+
+    wakeFd = ::eventfd(0, EFD_NONBLOCK);
+    if (wakeFd < 0) {
+        std::string message = errorText("Order gateway eventfd");
+        ::close(socketFd);
+        throw std::runtime_error(message);
+    }
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+    ::close(wakeFd);
+    ::close(socketFd);
+}
+
+void OrderGateway::start() {
+    running = true;
+    ioThread = std::thread([this]() { run(); });
+}
+
+void OrderGateway::stop() {
+    running = false;
+    uint64_t one = 1;
+    (void)::write(wakeFd, &one, sizeof(one));
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+}
+
+void OrderGateway::send(const Order& order) {
+    if (!running.load(std::memory_order_relaxed)) {
+        throw std::logic_error("Order gateway is not running");
+    }
+    if (order.symbol.size() > wire::SYMBOL_SIZE) {
+        throw std::invalid_argument("Symbol too long for the order wire format: " + order.symbol);
+    }
+
+    OrderRequest request;
+    request.price = order.price.ticks();
+    request.orderId = order.orderId;
+    request.quantity = order.quantity;
+    request.side = order.type == OrderType::BUY ? 'B' : 'S';
+    std::memset(request.symbol, ' ', sizeof(request.symbol));
+    std::memcpy(request.symbol, order.symbol.data(), order.symbol.size());
+
+    while (!queue.tryPush(request)) {
+        if (!running.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Order gateway stopped with the queue full");
+        }
+        std::this_thread::yield();
+    }
+    submitted.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in park(): either the I/O thread sees this order
+    // before it sleeps, or we see it sleeping and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        uint64_t one = 1;
+        (void)::write(wakeFd, &one, sizeof(one));
+    }
+}
+
+bool OrderGateway::waitForCompletion(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (completed.load(std::memory_order_acquire) < submitted.load(std::memory_order_relaxed)) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
+
+void OrderGateway::run() {
+    std::vector<uint8_t> out;
+    out.reserve(MAX_BATCH * (wire::LENGTH_SIZE + wire::NEW_ORDER_SIZE));
+
+    try {
+        int idle = 0;
+        while (true) {
+            bool stopping = !running.load(std::memory_order_acquire);
+            size_t count = drain(out);
+            if (count > 0) {
+                writeAll(out);
+                out.clear();
+            }
+            bool gotReports = readReports();
+            if (count > 0 || gotReports) {
+                idle = 0;
+                continue;
+            }
+            if (stopping) break; // Queue was empty after stop was requested
+            if (++idle >= SPIN_LIMIT) {
+                idle = 0;
+                park();
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Order gateway error: " << e.what() << std::endl;
+        running = false;
+    }
+}
+
+size_t OrderGateway::drain(std::vector<uint8_t>& out) {
+    const size_t frame = wire::LENGTH_SIZE + wire::NEW_ORDER_SIZE;
+    OrderRequest request;
+    size_t count = 0;
+    while (count < MAX_BATCH && queue.tryPop(request)) {
+        size_t offset = out.size();
+        out.resize(offset + frame);
+        uint8_t* p = out.data() + offset;
+        p = write<uint16_t>(p, static_cast<uint16_t>(wire::NEW_ORDER_SIZE));
+        p = write<uint8_t>(p, 'O');
+        p = write<uint32_t>(p, static_cast<uint32_t>(request.orderId));
+        p = write<uint8_t>(p, static_cast<uint8_t>(request.side));
+        p = write<uint32_t>(p, static_cast<uint32_t>(request.quantity));
+        p = write<int64_t>(p, request.price);
+        std::memcpy(p, request.symbol, wire::SYMBOL_SIZE);
+        ++count;
+    }
+    return count;
+}
+
+void OrderGateway::writeAll(const std::vector<uint8_t>& out) {
+    size_t offset = 0;
+    while (offset < out.size()) {
+        ssize_t n = ::send(socketFd, out.data() + offset, out.size() - offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Keep reading reports while the socket is full, or both sides
+            // could end up blocked on each other's buffers
+            pollfd pfd{socketFd, POLLOUT | POLLIN, 0};
+            ::poll(&pfd, 1, PARK_TIMEOUT_MS);
+            if (pfd.revents & POLLIN) {
+                readReports();
+            }
+            continue;
+        }
+        throw std::runtime_error(errorText("Order gateway send failed"));
+    }
+}
+
+bool OrderGateway::readReports() {
+    bool gotAny = false;
+    while (true) {
+        ssize_t n = ::recv(socketFd, inbound.data() + inboundUsed, inbound.size() - inboundUsed, 0);
+        if (n == 0) {
+            throw std::runtime_error("Broker closed the connection");
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            throw std::runtime_error(errorText("Order gateway receive failed"));
+        }
+        gotAny = true;
+        inboundUsed += static_cast<size_t>(n);
+
+        size_t pos = 0;
+        while (inboundUsed - pos >= wire::LENGTH_SIZE) {
+            size_t size = read<uint16_t>(inbound.data() + pos);
+            if (inboundUsed - pos - wire::LENGTH_SIZE < size) break; // Partial message
+            handleReport(inbound.data() + pos + wire::LENGTH_SIZE, size);
+            pos += wire::LENGTH_SIZE + size;
+        }
+        std::memmove(inbound.data(), inbound.data() + pos, inboundUsed - pos);
+        inboundUsed -= pos;
+    }
+    return gotAny;
+}
+
+void OrderGateway::handleReport(const uint8_t* msg, size_t size) {
+    if (size < wire::REPORT_SIZE) {
+        throw std::runtime_error("Execution report truncated");
+    }
+    int orderId = static_cast<int>(read<uint32_t>(msg + 1));
+    switch (static_cast<char>(msg[0])) {
+        case 'A':
+            manager.updateOrderStatus(orderId, OrderStatus::ACKNOWLEDGED);
+            acknowledged.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case 'F':
+            manager.updateOrderStatus(orderId, OrderStatus::FILLED);
+            completed.fetch_add(1, std::memory_order_release);
+            break;
+        case 'J':
+            manager.updateOrderStatus(orderId, OrderStatus::REJECTED);
+            completed.fetch_add(1, std::memory_order_release);
+            break;
+        default:
+            break; // Unknown report types are skipped
+    }
+}
+
+void OrderGateway::park() {
+    sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue.empty() && running.load(std::memory_order_acquire)) {
+        pollfd fds[2] = {{socketFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        ::poll(fds, 2, PARK_TIMEOUT_MS);
+    }
+    sleeping.store(false, std::memory_order_relaxed);
+
+    uint64_t wakeups;
+    (void)::read(wakeFd, &wakeups, sizeof(wakeups));
+}
+
+// BrokerSimulator implementation
+BrokerSimulator::BrokerSimulator() {
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(errorText("Broker simulator socket"));
+    }
+    int one = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr = loopback(0);
+    socklen_t length = sizeof(addr);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, 1) != 0 ||
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &length) != 0) {
+        std::string message = errorText("Broker simulator cannot listen");
+        ::close(listenFd);
+        throw std::runtime_error(message);
+    }
+    listenPort = ntohs(addr.sin_port);
+}
+
+BrokerSimulator::~BrokerSimulator() {
+    stop();
+    ::close(listenFd);
+}
+
+void BrokerSimulator::start() {
+    running = true;
+    brokerThread = std::thread([this]() { serve(); });
+}
+
+void BrokerSimulator::stop() {
+    running = false;
+    ::shutdown(listenFd, SHUT_RDWR);
+    int fd = clientFd.load();
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    if (brokerThread.joinable()) {
+        brokerThread.join();
+    }
+    fd = clientFd.exchange(-1);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void BrokerSimulator::serve() {
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+    clientFd = fd;
+    // stop() clears running before it looks at clientFd, so one of us sees the other
+    if (!running) return;
+    setNoDelay(fd);
+
+    std::vector<uint8_t> in(RECEIVE_BUFFER);
+    std::vector<uint8_t> out;
+    size_t used = 0;
+    while (true) {
+        ssize_t n = ::recv(fd, in.data() + used, in.size() - used, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        used += static_cast<size_t>(n);
+
+        size_t pos = 0;
+        while (used - pos >= wire::LENGTH_SIZE) {
+            size_t size = read<uint16_t>(in.data() + pos);
+            if (used - pos - wire::LENGTH_SIZE < size) break; // Partial message
+            const uint8_t* msg = in.data() + pos + wire::LENGTH_SIZE;
+            if (size >= wire::NEW_ORDER_SIZE && msg[0] == 'O') {
+                uint32_t orderId = read<uint32_t>(msg + 1);
+                int32_t quantity = read<int32_t>(msg + 6);
+                int64_t price = read<int64_t>(msg + 10);
+                if (quantity > 0 && price > 0) {
+                    appendReport(out, 'A', orderId, static_cast<uint32_t>(quantity), price);
+                    appendReport(out, 'F', orderId, static_cast<uint32_t>(quantity), price);
+                } else {
+                    appendReport(out, 'J', orderId, static_cast<uint32_t>(quantity), price);
+                }
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+            pos += wire::LENGTH_SIZE + size;
+        }
+        std::memmove(in.data(), in.data() + pos, used - pos);
+        used -= pos;
+
+        // One write for every report produced by this read
+        size_t offset = 0;
+        while (offset < out.size()) {
+            ssize_t sent = ::send(fd, out.data() + offset, out.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) return;
+            offset += static_cast<size_t>(sent);
+        }
+        out.clear();
+    }
+}
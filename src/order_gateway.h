@@ -0,0 +1,144 @@
+#ifndef ORDER_GATEWAY_H
+#define ORDER_GATEWAY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include "order_manager.h"
+
+// Binary order entry protocol between OrderGateway and a broker, little-endian.
+//
+// Every message is framed as a u16 length (bytes that follow) and a payload
+// that starts with a one-byte type:
+//   'O' new order         u32 order id, u8 side ('B'/'S'), u32 quantity,
+//                         i64 price (ticks), char[8] symbol (space padded)
+//   'A' order accepted    u32 order id, u32 quantity, i64 price
+//   'F' order filled      u32 order id, u32 quantity, i64 price
+//   'J' order rejected    u32 order id, u32 quantity, i64 price
+namespace wire {
+
+constexpr size_t LENGTH_SIZE = 2;
+constexpr size_t NEW_ORDER_SIZE = 26;
+constexpr size_t REPORT_SIZE = 17;
+constexpr size_t SYMBOL_SIZE = 8;
+
+} // namespace wire
+
+// Order as it travels from a strategy thread to the I/O thread: fixed size
+// and trivially copyable, so enqueueing never allocates.
+struct OrderRequest {
+    int64_t price;
+    int32_t orderId;
+    int32_t quantity;
+    char side;
+    char symbol[wire::SYMBOL_SIZE];
+};
+
+// Bounded lock-free queue for many producers and one consumer. Each cell
+// carries a sequence number that tells producers and the consumer whose turn
+// it is, so neither side takes a lock.
+class OrderQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        OrderRequest request;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0}; // Next slot for producers
+    alignas(64) size_t head = 0;             // Next slot for the consumer
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit OrderQueue(size_t capacity);
+
+    bool tryPush(const OrderRequest& request);
+    bool tryPop(OrderRequest& request);
+    bool empty() const;
+};
+
+// Takes orders from strategy threads and sends them to the broker from a
+// dedicated I/O thread. send() only copies the order into a lock-free queue;
+// the I/O thread drains the queue, encodes whole batches into one buffer,
+// writes each batch with a single call and feeds the broker's execution
+// reports back into OrderManager::updateOrderStatus.
+class OrderGateway {
+private:
+    OrderManager& manager;
+    OrderQueue queue;
+    int socketFd = -1;
+    int wakeFd = -1;  // eventfd that rouses the I/O thread when it is parked
+    std::thread ioThread;
+    std::atomic<bool> running{false};
+    alignas(64) std::atomic<bool> sleeping{false};
+    alignas(64) std::atomic<uint64_t> submitted{0};
+    alignas(64) std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> acknowledged{0};
+    std::vector<uint8_t> inbound;
+    size_t inboundUsed = 0;
+
+    void run();
+    size_t drain(std::vector<uint8_t>& out);
+    void writeAll(const std::vector<uint8_t>& out);
+    bool readReports();
+    void handleReport(const uint8_t* msg, size_t size);
+    void park();
+
+public:
+    // Connects to a broker listening on 127.0.0.1:port
+    OrderGateway(OrderManager& orderManager, uint16_t port, size_t queueCapacity = 1 << 16);
+    ~OrderGateway();
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    void start();
+    // Sends everything already queued, then stops the I/O thread
+    void stop();
+
+    // Queues an order for the I/O thread; safe to call from any thread.
+    // Waits for room if the queue is full.
+    void send(const Order& order);
+
+    // Waits until every order sent so far has been filled or rejected.
+    // Returns false if the timeout expires first.
+    bool waitForCompletion(std::chrono::milliseconds timeout);
+
+    uint64_t ordersSent() const { return submitted.load(); }
+    uint64_t ordersAcknowledged() const { return acknowledged.load(); }
+    uint64_t ordersCompleted() const { return completed.load(); }
+};
+
+// Local stand-in for a broker: accepts one gateway connection on loopback,
+// acknowledges every order and fills it in full at its limit price. Orders
+// with a non-positive quantity or price are rejected.
+class BrokerSimulator {
+private:
+    int listenFd = -1;
+    std::atomic<int> clientFd{-1};
+    uint16_t listenPort = 0;
+    std::thread brokerThread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> received{0};
+
+    void serve();
+
+public:
+    // Listens on an ephemeral port; see port()
+    BrokerSimulator();
+    ~BrokerSimulator();
+    BrokerSimulator(const BrokerSimulator&) = delete;
+    BrokerSimulator& operator=(const BrokerSimulator&) = delete;
+
+    void start();
+    void stop();
+
+    uint16_t port() const { return listenPort; }
+    uint64_t ordersReceived() const { return received.load(); }
+};
+
+#endif // ORDER_GATEWAY_H
@@ -1,13 +1,63 @@
 #include "order_manager.h"
+#include "order_gateway.h"
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
-int OrderManager::submitOrder(const std::string& symbol, OrderType type, int quantity, double price) {
+namespace {
+
+constexpr uint64_t packState(int orderId, OrderStatus status) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(orderId)) << 8) | static_cast<uint64_t>(status);
+}
+
+constexpr int stateOrderId(uint64_t state) { return static_cast<int>(state >> 8); }
+
+constexpr OrderStatus stateStatus(uint64_t state) { return static_cast<OrderStatus>(state & 0xFF); }
+
+bool isOpen(uint64_t state) {
+    if (state == 0) return false;
+    OrderStatus status = stateStatus(state);
+    return status == OrderStatus::PENDING || status == OrderStatus::ACKNOWLEDGED;
+}
+
+// Holds a slot's busy flag for the current scope. Only a submitter reusing
+// the slot and a getOrder() copying it ever contend, so the wait is short.
+class SlotGuard {
+private:
+    std::atomic_flag& flag;
+
+public:
+    explicit SlotGuard(std::atomic_flag& f) : flag(f) {
+        while (flag.test_and_set(std::memory_order_acquire)) {}
+    }
+    ~SlotGuard() { flag.clear(std::memory_order_release); }
+    SlotGuard(const SlotGuard&) = delete;
+    SlotGuard& operator=(const SlotGuard&) = delete;
+};
+
+} // namespace
+
+OrderManager::OrderManager(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    slots = std::make_unique<Slot[]>(size);
+    mask = size - 1;
+}
+
+int OrderManager::submitOrder(const std::string& symbol, OrderType type, int quantity, Price price) {
     int orderId = nextOrderId++;
     Order order(orderId, symbol, type, quantity, price);
     
+    Slot& slot = slotFor(orderId);
     {
-        std::lock_guard<std::mutex> lock(ordersMutex);
-        orders[orderId] = order;
+        SlotGuard guard(slot.busy);
+        uint64_t previous = slot.state.load(std::memory_order_acquire);
+        if (isOpen(previous)) {
+            throw std::runtime_error("Order " + std::to_string(orderId) + " would retire order " +
+                                     std::to_string(stateOrderId(previous)) + ", which is still open");
+        }
+        slot.order = order;
+        slot.state.store(packState(orderId, OrderStatus::PENDING), std::memory_order_release);
     }
     
     sendToBroker(order);
@@ -15,18 +65,42 @@ int OrderManager::submitOrder(const std::string& symbol, OrderType type, int qua
 }
 
 void OrderManager::updateOrderStatus(int orderId, OrderStatus status) {
-    std::lock_guard<std::mutex> lock(ordersMutex);
-    auto it = orders.find(orderId);
-    if (it != orders.end()) {
-        std::cout << "Order " << orderId << " status updated" << std::endl;
+    Slot& slot = slotFor(orderId);
+    uint64_t state = slot.state.load(std::memory_order_relaxed);
+    while (state != 0 && stateOrderId(state) == orderId &&
+           !slot.state.compare_exchange_weak(state, packState(orderId, status), std::memory_order_release,
+                                             std::memory_order_relaxed)) {}
+}
+
+Order OrderManager::getOrder(int orderId) const {
+    Slot& slot = slotFor(orderId);
+    SlotGuard guard(slot.busy);
+    uint64_t state = slot.state.load(std::memory_order_acquire);
+    if (state == 0 || stateOrderId(state) != orderId) {
+        throw std::out_of_range("Order " + std::to_string(orderId) + " is unknown or retired");
     }
+    return slot.order;
 }
 
-Order OrderManager::getOrder(int orderId) {
-    std::lock_guard<std::mutex> lock(ordersMutex);
-    return orders.at(orderId);
+OrderStatus OrderManager::getOrderStatus(int orderId) const {
+    uint64_t state = slotFor(orderId).state.load(std::memory_order_acquire);
+    if (state == 0 || stateOrderId(state) != orderId) {
+        throw std::out_of_range("Order " + std::to_string(orderId) + " is unknown or retired");
+    }
+    return stateStatus(state);
 }
 
 void OrderManager::sendToBroker(const Order& order) {
+    if (gateway) {
+        // An order the gateway refuses never reaches the broker; record it as
+        // rejected rather than leaving it pending forever
+        try {
+            gateway->send(order);
+        } catch (const std::exception& e) {
+            std::cerr << "Order " << order.orderId << " rejected by gateway: " << e.what() << std::endl;
+            updateOrderStatus(order.orderId, OrderStatus::REJECTED);
+        }
+        return;
+    }
     std::cout << "Sending order to broker: " << order.symbol << std::endl;
 }
\ No newline at end of file
@@ -1,25 +1,55 @@
 #ifndef ORDER_MANAGER_H
 #define ORDER_MANAGER_H
 
-#include <unordered_map>
-#include <mutex>
+#include <memory>
 #include <atomic>
 #include "strategy.h"
 
-enum class OrderStatus { PENDING, FILLED, CANCELLED, REJECTED };
+enum class OrderStatus { PENDING, ACKNOWLEDGED, FILLED, CANCELLED, REJECTED };
 
+class OrderGateway;
+
+// Tracks orders in a preallocated ring of slots indexed by order id, so
+// submitting and status updates never take a shared lock or allocate. Each
+// slot's state packs the order id with its status in one atomic word: the
+// gateway's I/O thread updates it with a compare-and-swap and readers load it.
+// A completed order is retired when a newer id wraps onto its slot; after
+// that it can no longer be looked up. Submitting while the order occupying
+// the slot is still open throws, so open orders are never lost.
 class OrderManager {
 private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> state{0};         // Order id << 8 | status; 0 while unused
+        std::atomic_flag busy = ATOMIC_FLAG_INIT; // Held while the order details are written or copied
+        Order order;
+    };
+
     std::atomic<int> nextOrderId{1};
-    std::unordered_map<int, Order> orders;
-    std::mutex ordersMutex;
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    OrderGateway* gateway = nullptr;
     
+    Slot& slotFor(int orderId) const { return slots[static_cast<size_t>(orderId) & mask]; }
     void sendToBroker(const Order& order);
     
 public:
-    int submitOrder(const std::string& symbol, OrderType type, int quantity, double price);
+    // Keeps the most recent capacity orders (rounded up to a power of two)
+    explicit OrderManager(size_t capacity = 1 << 16);
+    
+    int submitOrder(const std::string& symbol, OrderType type, int quantity, Price price);
+    int submitOrder(const std::string& symbol, OrderType type, int quantity, double price) {
+        return submitOrder(symbol, type, quantity, Price::fromDouble(symbol, price));
+    }
+    // Ignored for orders that have been retired
     void updateOrderStatus(int orderId, OrderStatus status);
-    Order getOrder(int orderId);
+    // Both throw std::out_of_range for ids never issued or already retired
+    Order getOrder(int orderId) const;
+    OrderStatus getOrderStatus(int orderId) const;
+    
+    // Routes orders through an asynchronous gateway instead of sending them
+    // inline; the gateway reports back through updateOrderStatus. Orders the
+    // gateway refuses (bad symbol, gateway stopped) are marked REJECTED.
+    void setGateway(OrderGateway* orderGateway) { gateway = orderGateway; }
 };
 
 #endif // ORDER_MANAGER_H
\ No newline at end of file
@@ -1,48 +1,92 @@
 #include "portfolio.h"
+#include <algorithm>
+#include <cstdlib>
 
-Portfolio::Portfolio(double initialCash) : cash(initialCash), totalPnL(0.0) {}
+namespace {
 
-void Portfolio::updatePosition(const std::string& symbol, int quantity, double price) {
-    double currentPos = positions[symbol];
-    double currentAvg = avgPrices[symbol];
+// value * num / den (den > 0) truncated toward zero, without overflowing the
+// intermediate product.
+Money scaleBasis(Money value, int64_t num, int64_t den) {
+    int64_t q = value.micros() / den;
+    int64_t r = value.micros() % den;
+    return Money(q * num + r * num / den);
+}
+
+std::unordered_map<std::string, Price> toPrices(const std::unordered_map<std::string, double>& prices) {
+    std::unordered_map<std::string, Price> result;
+    for (const auto& p : prices) {
+        result.emplace(p.first, Price::fromDouble(p.first, p.second));
+    }
+    return result;
+}
+
+} // namespace
+
+Portfolio::Portfolio(double initialCash) : cash(Money::fromDouble(initialCash)), totalPnL() {}
+
+void Portfolio::updatePosition(const std::string& symbol, int quantity, Price price) {
+    int64_t& position = positions[symbol];
+    Money& basis = costBasis[symbol];
     
-    if (quantity > 0) { // Buy
-        if (currentPos >= 0) {
-            avgPrices[symbol] = (currentPos * currentAvg + quantity * price) / 
-                               (currentPos + quantity);
-        }
-        positions[symbol] += quantity;
-        cash -= quantity * price;
-    } else { // Sell
-        positions[symbol] += quantity;
-        cash -= quantity * price;
-        
-        double realizedPnL = -quantity * (price - currentAvg);
-        totalPnL += realizedPnL;
+    cash -= TickSizes::notional(symbol, price, quantity);
+    
+    if (position == 0 || (position > 0) == (quantity > 0)) { // Opening or adding
+        basis += TickSizes::notional(symbol, price, quantity);
+        position += quantity;
+        return;
+    }
+    
+    // Reducing: realize P&L on the closed part against its share of the basis
+    int64_t closed = std::min<int64_t>(std::abs(quantity), std::abs(position));
+    int64_t closedQty = quantity > 0 ? closed : -closed;
+    Money released = scaleBasis(basis, closed, std::abs(position));
+    
+    totalPnL += -TickSizes::notional(symbol, price, closedQty) - released;
+    basis -= released;
+    position += closedQty;
+    
+    // Flipping through zero opens a new position with the remainder
+    int64_t remainder = quantity - closedQty;
+    if (remainder != 0) {
+        basis += TickSizes::notional(symbol, price, remainder);
+        position += remainder;
     }
 }
 
-double Portfolio::getUnrealizedPnL(const std::unordered_map<std::string, double>& currentPrices) const {
-    double unrealizedPnL = 0.0;
+Money Portfolio::getUnrealizedPnL(const std::unordered_map<std::string, Price>& currentPrices) const {
+    Money unrealizedPnL;
     for (const auto& pos : positions) {
         auto priceIt = currentPrices.find(pos.first);
         if (priceIt != currentPrices.end()) {
-            unrealizedPnL += pos.second * (priceIt->second - avgPrices.at(pos.first));
+            unrealizedPnL += TickSizes::notional(pos.first, priceIt->second, pos.second) - costBasis.at(pos.first);
         }
     }
     return unrealizedPnL;
 }
 
-double Portfolio::getTotalValue(const std::unordered_map<std::string, double>& currentPrices) const {
-    double stockValue = 0.0;
+Money Portfolio::getTotalValue(const std::unordered_map<std::string, Price>& currentPrices) const {
+    Money stockValue;
     
     // Calculate current market value of all positions
     for (const auto& pos : positions) {
         auto priceIt = currentPrices.find(pos.first);
         if (priceIt != currentPrices.end()) {
-            stockValue += pos.second * priceIt->second; // position * current_price
+            stockValue += TickSizes::notional(pos.first, priceIt->second, pos.second); // position * current_price
         }
     }
     
     return cash + stockValue;
+}
+
+double Portfolio::getUnrealizedPnL(const std::unordered_map<std::string, double>& currentPrices) const {
+    return getUnrealizedPnL(toPrices(currentPrices)).toDouble();
+}
+
+double Portfolio::getTotalValue(const std::unordered_map<std::string, double>& currentPrices) const {
+    return getTotalValue(toPrices(currentPrices)).toDouble();
+}
+
+int64_t Portfolio::getPosition(const std::string& symbol) const {
+    auto it = positions.find(symbol);
+    return (it != positions.end()) ? it->second : 0;
 }
\ No newline at end of file
@@ -3,20 +3,33 @@
 
 #include <unordered_map>
 #include <string>
+#include "price.h"
 
 class Portfolio {
 private:
-    std::unordered_map<std::string, double> positions;
-    std::unordered_map<std::string, double> avgPrices;
-    double cash;
-    double totalPnL;
+    std::unordered_map<std::string, int64_t> positions;
+    // Signed cost of the open position: positive for longs, negative for shorts
+    std::unordered_map<std::string, Money> costBasis;
+    Money cash;
+    Money totalPnL;
     
 public:
     Portfolio(double initialCash);
-    void updatePosition(const std::string& symbol, int quantity, double price);
+    void updatePosition(const std::string& symbol, int quantity, Price price);
+    void updatePosition(const std::string& symbol, int quantity, double price) {
+        updatePosition(symbol, quantity, Price::fromDouble(symbol, price));
+    }
+    
+    Money getUnrealizedPnL(const std::unordered_map<std::string, Price>& currentPrices) const;
+    Money getTotalValue(const std::unordered_map<std::string, Price>& currentPrices) const;
+    // Analytics conveniences taking and returning plain doubles
     double getUnrealizedPnL(const std::unordered_map<std::string, double>& currentPrices) const;
     double getTotalValue(const std::unordered_map<std::string, double>& currentPrices) const;
-    double getCash() const { return cash; }
+    
+    double getCash() const { return cash.toDouble(); }
+    Money getCashExact() const { return cash; }
+    Money getRealizedPnL() const { return totalPnL; }
+    int64_t getPosition(const std::string& symbol) const;
 };
 
 #endif // PORTFOLIO_H
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "price.h"
+#include "config.h"
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+std::unordered_map<std::string, int64_t> TickSizes::microsPerTick;
+int64_t TickSizes::defaultMicrosPerTick = Money::MICROS_PER_UNIT / 100;
+
+// Price implementation
+Price Price::fromDouble(const std::string& symbol, double value) {
+    return Price(std::llround(value * Money::MICROS_PER_UNIT / TickSizes::tickValue(symbol)));
+}
+
+double Price::toDouble(const std::string& symbol) const {
+    // Exact integer product, then a single rounding division
+    return static_cast<double>(tickCount * TickSizes::tickValue(symbol)) / Money::MICROS_PER_UNIT;
+}
+
+// Money implementation
+Money Money::fromDouble(double value) {
+    return Money(std::llround(value * MICROS_PER_UNIT));
+}
+
+// TickSizes implementation
+int64_t TickSizes::toMicros(double tickSize) {
+    int64_t micros = std::llround(tickSize * Money::MICROS_PER_UNIT);
+    if (micros <= 0) {
+        throw std::invalid_argument("Tick size must be at least one millionth");
+    }
+    return micros;
+}
+
+void TickSizes::setDefault(double tickSize) {
+    defaultMicrosPerTick = toMicros(tickSize);
+}
+
+void TickSizes::set(const std::string& symbol, double tickSize) {
+    microsPerTick[symbol] = toMicros(tickSize);
+}
+
+int64_t TickSizes::tickValue(const std::string& symbol) {
+    auto it = microsPerTick.find(symbol);
+    return (it != microsPerTick.end()) ? it->second : defaultMicrosPerTick;
+}
+
+double TickSizes::tickSize(const std::string& symbol) {
+    return static_cast<double>(tickValue(symbol)) / Money::MICROS_PER_UNIT;
+}
+
+void TickSizes::loadFromConfig(const Config& config) {
+    double defaultSize = static_cast<double>(defaultMicrosPerTick) / Money::MICROS_PER_UNIT;
+    setDefault(config.get<double>("tick_size", defaultSize));
+
+    std::stringstream symbols(config.get<std::string>("symbols", ""));
+    std::string symbol;
+    while (std::getline(symbols, symbol, ',')) {
+        double size = config.get<double>("tick_size." + symbol, 0.0);
+        if (size > 0.0) {
+            set(symbol, size);
+        }
+    }
+}
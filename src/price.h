@@ -0,0 +1,97 @@
+#ifndef PRICE_H
+#define PRICE_H
+
+#include <cstdint>
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+class Config;
+
+// Fixed-point price: a whole number of the instrument's ticks. Prices of the
+// same instrument compare and hash as plain integers; converting to double
+// needs the instrument's tick size and is meant for display and analytics.
+class Price {
+private:
+    int64_t tickCount;
+
+public:
+    constexpr Price() : tickCount(0) {}
+    constexpr explicit Price(int64_t ticks) : tickCount(ticks) {}
+
+    static Price fromDouble(const std::string& symbol, double value);
+    double toDouble(const std::string& symbol) const;
+
+    constexpr int64_t ticks() const { return tickCount; }
+
+    constexpr Price operator+(Price other) const { return Price(tickCount + other.tickCount); }
+    constexpr Price operator-(Price other) const { return Price(tickCount - other.tickCount); }
+    constexpr bool operator==(Price other) const { return tickCount == other.tickCount; }
+    constexpr bool operator!=(Price other) const { return tickCount != other.tickCount; }
+    constexpr bool operator<(Price other) const { return tickCount < other.tickCount; }
+    constexpr bool operator>(Price other) const { return tickCount > other.tickCount; }
+    constexpr bool operator<=(Price other) const { return tickCount <= other.tickCount; }
+    constexpr bool operator>=(Price other) const { return tickCount >= other.tickCount; }
+};
+
+// Cash amount in millionths of the account currency, so cash, cost basis and
+// P&L are exact sums of integer products.
+class Money {
+private:
+    int64_t microCount;
+
+public:
+    static constexpr int64_t MICROS_PER_UNIT = 1000000;
+
+    constexpr Money() : microCount(0) {}
+    constexpr explicit Money(int64_t micros) : microCount(micros) {}
+
+    static Money fromDouble(double value);
+    double toDouble() const { return static_cast<double>(microCount) / MICROS_PER_UNIT; }
+
+    constexpr int64_t micros() const { return microCount; }
+
+    constexpr Money operator+(Money other) const { return Money(microCount + other.microCount); }
+    constexpr Money operator-(Money other) const { return Money(microCount - other.microCount); }
+    constexpr Money operator-() const { return Money(-microCount); }
+    Money& operator+=(Money other) { microCount += other.microCount; return *this; }
+    Money& operator-=(Money other) { microCount -= other.microCount; return *this; }
+    constexpr bool operator==(Money other) const { return microCount == other.microCount; }
+    constexpr bool operator!=(Money other) const { return microCount != other.microCount; }
+    constexpr bool operator<(Money other) const { return microCount < other.microCount; }
+    constexpr bool operator>(Money other) const { return microCount > other.microCount; }
+};
+
+// Per-instrument tick sizes, configured once at startup before any prices are
+// converted. Symbols without an entry use the default tick size (0.01 unless
+// overridden). Not thread-safe for writes.
+class TickSizes {
+private:
+    static std::unordered_map<std::string, int64_t> microsPerTick;
+    static int64_t defaultMicrosPerTick;
+
+    static int64_t toMicros(double tickSize);
+
+public:
+    static void setDefault(double tickSize);
+    static void set(const std::string& symbol, double tickSize);
+    static int64_t tickValue(const std::string& symbol); // Micro-units per tick
+    static double tickSize(const std::string& symbol);
+
+    // Reads "tick_size" and "tick_size.<SYMBOL>" for every symbol in "symbols"
+    static void loadFromConfig(const Config& config);
+
+    // Cash value of quantity units at price
+    static Money notional(const std::string& symbol, Price price, int64_t quantity) {
+        return Money(price.ticks() * tickValue(symbol) * quantity);
+    }
+};
+
+namespace std {
+template<>
+struct hash<Price> {
+    size_t operator()(Price price) const { return std::hash<int64_t>()(price.ticks()); }
+};
+}
+
+#endif // PRICE_H
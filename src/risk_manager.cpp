@@ -1,13 +1,14 @@
 #include "risk_manager.h"
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
 
 RiskManager::RiskManager(double maxPos, double maxLoss) 
-    : maxPositionSize(maxPos), maxDailyLoss(maxLoss), currentPnL(0.0) {}
+    : maxPositionSize(Money::fromDouble(maxPos)), maxDailyLoss(Money::fromDouble(maxLoss)), currentPnL() {}
 
-bool RiskManager::validateOrder(const Order& order, double currentPosition) {
+bool RiskManager::validateOrder(const Order& order, int64_t currentPosition) {
     // Calculate the dollar value of the new position
-    double newPosition = currentPosition;
+    int64_t newPosition = currentPosition;
     if (order.type == OrderType::BUY) {
         newPosition += order.quantity;
     } else {
@@ -15,10 +16,10 @@ bool RiskManager::validateOrder(const Order& order, double currentPosition) {
     }
     
     // Check position size limit (in dollar terms)
-    double positionValue = std::abs(newPosition * order.price);
+    Money positionValue = TickSizes::notional(order.symbol, order.price, std::abs(newPosition));
     if (positionValue > maxPositionSize) {
         std::cout << "Order rejected: Position size limit exceeded ($" 
-                  << positionValue << " > $" << maxPositionSize << ")" << std::endl;
+                  << positionValue.toDouble() << " > $" << maxPositionSize.toDouble() << ")" << std::endl;
         return false;
     }
     
@@ -38,12 +39,12 @@ bool RiskManager::validateOrder(const Order& order, double currentPosition) {
     return true;
 }
 
-void RiskManager::updatePnL(double pnl) {
+void RiskManager::updatePnL(Money pnl) {
     currentPnL += pnl;
-    std::cout << "Updated P&L: $" << currentPnL << std::endl;
+    std::cout << "Updated P&L: $" << currentPnL.toDouble() << std::endl;
 }
 
 void RiskManager::resetDailyPnL() {
-    currentPnL = 0.0;
+    currentPnL = Money();
     std::cout << "Daily P&L reset" << std::endl;
 }
\ No newline at end of file
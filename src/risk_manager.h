@@ -6,15 +6,16 @@
 
 class RiskManager {
 private:
-    double maxPositionSize;
-    double maxDailyLoss;
-    double currentPnL;
-    std::unordered_map<std::string, double> positionLimits;
+    Money maxPositionSize;
+    Money maxDailyLoss;
+    Money currentPnL;
+    std::unordered_map<std::string, int64_t> positionLimits;
     
 public:
     RiskManager(double maxPos, double maxLoss);
-    bool validateOrder(const Order& order, double currentPosition);
-    void updatePnL(double pnl);
+    bool validateOrder(const Order& order, int64_t currentPosition);
+    void updatePnL(Money pnl);
+    void updatePnL(double pnl) { updatePnL(Money::fromDouble(pnl)); }
     void resetDailyPnL();
 };
 
@@ -1,36 +1,45 @@
 #include "strategy.h"
+#include <stdexcept>
 
 Strategy::Strategy(const std::string& strategyName, double initialCash) 
-    : name(strategyName), cash(initialCash) {}
+    : name(strategyName), cash(Money::fromDouble(initialCash)) {}
 
-void Strategy::generateOrder(const std::string& symbol, OrderType type, int quantity, double price) {
+void Strategy::generateOrder(const std::string& symbol, OrderType type, int quantity, Price price) {
     std::cout << "Generated Order: " << symbol 
               << (type == OrderType::BUY ? " BUY " : " SELL ")
-              << quantity << " @ $" << std::fixed << std::setprecision(2) << price << std::endl;
+              << quantity << " @ $" << std::fixed << std::setprecision(2) << price.toDouble(symbol) << std::endl;
 }
 
-double Strategy::getPosition(const std::string& symbol) const {
+void Strategy::onMarketDataBatch(const MarketData* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        onMarketData(data[i]);
+    }
+}
+
+int64_t Strategy::getPosition(const std::string& symbol) const {
     auto it = positions.find(symbol);
-    return (it != positions.end()) ? it->second : 0.0;
+    return (it != positions.end()) ? it->second : 0;
 }
 
 MovingAverageCrossover::MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash)
-    : Strategy("MA_Crossover", initialCash), symbol(sym), shortPeriod(shortP), longPeriod(longP) {}
+    : MovingAverageCrossover(sym, shortP, longP, initialCash, std::make_unique<IndicatorRegistry>()) {}
 
-void MovingAverageCrossover::updateMovingAverages() {
-    // Calculate short moving average
-    if (prices.size() >= static_cast<size_t>(shortPeriod)) {
-        shortMA = std::accumulate(prices.end() - shortPeriod, prices.end(), 0.0) / shortPeriod;
-    }
-    
-    // Calculate long moving average - FIXED: use correct period
-    if (prices.size() >= static_cast<size_t>(longPeriod)) {
-        longMA = std::accumulate(prices.end() - longPeriod, prices.end(), 0.0) / longPeriod;
-    }
-}
+MovingAverageCrossover::MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash,
+                                               IndicatorRegistry& registry)
+    : Strategy("MA_Crossover", initialCash), symbol(sym), shortPeriod(shortP), longPeriod(longP),
+      shortMA(registry.subscribe(sym, IndicatorType::SMA, shortP)),
+      longMA(registry.subscribe(sym, IndicatorType::SMA, longP)),
+      seenSequence(shortMA.sequence()) {}
+
+MovingAverageCrossover::MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash,
+                                               std::unique_ptr<IndicatorRegistry> registry)
+    : Strategy("MA_Crossover", initialCash), symbol(sym), shortPeriod(shortP), longPeriod(longP),
+      ownRegistry(std::move(registry)),
+      shortMA(ownRegistry->subscribe(sym, IndicatorType::SMA, shortP)),
+      longMA(ownRegistry->subscribe(sym, IndicatorType::SMA, longP)) {}
 
 // This is the key fix - implement the virtual function
-void MovingAverageCrossover::generateOrder(const std::string& symbol, OrderType type, int quantity, double price) {
+void MovingAverageCrossover::generateOrder(const std::string& symbol, OrderType type, int quantity, Price price) {
     // Call the parent implementation
     Strategy::generateOrder(symbol, type, quantity, price);
 }
@@ -38,16 +47,17 @@ void MovingAverageCrossover::generateOrder(const std::string& symbol, OrderType
 void MovingAverageCrossover::onMarketData(const MarketData& data) {
     if (data.symbol != symbol) return;
     
-    prices.push_back(data.last);
-    if (prices.size() > static_cast<size_t>(longPeriod)) {
-        prices.pop_front();
+    // A private registry is ours to update; a shared one is updated by the trading loop
+    if (ownRegistry) {
+        ownRegistry->onMarketData(data);
+    } else if (shortMA.sequence() != ++seenSequence) {
+        throw std::logic_error("Shared indicator registry is out of step with this strategy; deliver ticks with dispatchTicks");
     }
     
-    updateMovingAverages();
-    
     // Only start trading when we have enough data for both averages
-    if (prices.size() >= static_cast<size_t>(longPeriod)) {
-        bool currentCrossAbove = (shortMA > longMA);
+    if (shortMA.ready() && longMA.ready()) {
+        // Compared exactly, so near-ties are not lost to double rounding
+        bool currentCrossAbove = shortMA.compare(longMA) > 0;
         
         // Check for crossover signals
         if (currentCrossAbove && !prevCrossAbove) {
@@ -64,8 +74,8 @@ void MovingAverageCrossover::onMarketData(const MarketData& data) {
         static int counter = 0;
         if (++counter % 5 == 0) {
             std::cout << "  MA Values - Short(" << shortPeriod << "): " 
-                      << std::fixed << std::setprecision(3) << shortMA 
-                      << ", Long(" << longPeriod << "): " << longMA;
+                      << std::fixed << std::setprecision(3) << shortMA.value() 
+                      << ", Long(" << longPeriod << "): " << longMA.value();
             if (currentCrossAbove) {
                 std::cout << " [Short > Long]";
             } else {
@@ -80,10 +90,56 @@ void MovingAverageCrossover::onOrderFilled(const Order& order) {
     std::cout << "Order filled: " << order.symbol << std::endl;
 }
 
-void MovingAverageCrossover::onTimer() {
+void MovingAverageCrossover::onTimer(TimerId /*timerId*/) {
     // Timer-based logic if needed
 }
 
+void dispatchTicks(IndicatorRegistry* registry, Strategy* const* strategies, size_t strategyCount,
+                   const MarketData* data, size_t count) {
+    if (!registry) {
+        for (size_t s = 0; s < strategyCount; ++s) {
+            strategies[s]->onMarketDataBatch(data, count);
+        }
+        return;
+    }
+    size_t begin = 0;
+    for (size_t i = 0; i < count; ++i) {
+        IndicatorRegistry::SymbolSeries* series = registry->find(data[i].symbol);
+        if (!series) continue;
+        // Ticks before this one don't move any shared series, so they can be
+        // handed over as a batch before the registry moves on
+        if (i > begin) {
+            for (size_t s = 0; s < strategyCount; ++s) {
+                strategies[s]->onMarketDataBatch(data + begin, i - begin);
+            }
+        }
+        registry->advance(*series, data[i]);
+        for (size_t s = 0; s < strategyCount; ++s) {
+            strategies[s]->onMarketData(data[i]);
+        }
+        begin = i + 1;
+    }
+    if (count > begin) {
+        for (size_t s = 0; s < strategyCount; ++s) {
+            strategies[s]->onMarketDataBatch(data + begin, count - begin);
+        }
+    }
+}
+
+void dispatchTicksOnDataTime(TimerService& timers, IndicatorRegistry* registry, Strategy* const* strategies,
+                             size_t strategyCount, const MarketData* data, size_t count) {
+    size_t begin = 0;
+    while (begin < count) {
+        size_t end = begin + 1;
+        while (end < count && data[end].timestamp == data[begin].timestamp) {
+            ++end;
+        }
+        timers.advanceTo(data[begin].timestamp);
+        dispatchTicks(registry, strategies, strategyCount, data + begin, end - begin);
+        begin = end;
+    }
+}
+
 // Order default constructor
 Order::Order()
-    : orderId(0), symbol(""), type(OrderType::BUY), quantity(0), price(0.0) {}
\ No newline at end of file
+    : orderId(0), symbol(""), type(OrderType::BUY), quantity(0), price() {}
\ No newline at end of file
@@ -3,11 +3,12 @@
 
 #include <string>
 #include <unordered_map>
-#include <deque>
-#include <numeric>
+#include <memory>
 #include <iostream>
 #include <iomanip>
 #include "market_data.h"
+#include "indicator.h"
+#include "timer_service.h"
 
 enum class OrderType { BUY, SELL };
 
@@ -17,53 +18,88 @@ public:
     std::string symbol;
     OrderType type;
     int quantity;
-    double price;
+    Price price;
     Order();
-    Order(int id, const std::string& sym, OrderType t, int qty, double p)
+    Order(int id, const std::string& sym, OrderType t, int qty, Price p)
         : orderId(id), symbol(sym), type(t), quantity(qty), price(p) {}
+    // Converts the price using the symbol's tick size
+    Order(int id, const std::string& sym, OrderType t, int qty, double p)
+        : Order(id, sym, t, qty, Price::fromDouble(sym, p)) {}
 };
 
 class Strategy {
 protected:
     std::string name;
-    std::unordered_map<std::string, double> positions;
-    double cash;
+    std::unordered_map<std::string, int64_t> positions;
+    Money cash;
+    TimerService* timers = nullptr; // For scheduling onTimer callbacks; set by the trading loop
     
-    virtual void generateOrder(const std::string& symbol, OrderType type, int quantity, double price);
+    virtual void generateOrder(const std::string& symbol, OrderType type, int quantity, Price price);
     
 public:
     Strategy(const std::string& strategyName, double initialCash);
     virtual ~Strategy() = default;
     
     virtual void onMarketData(const MarketData& data) = 0;
+    // Ticks in arrival order; override to amortize per-tick work across a batch
+    virtual void onMarketDataBatch(const MarketData* data, size_t count);
     virtual void onOrderFilled(const Order& order) = 0;
-    virtual void onTimer() = 0;
+    virtual void onTimer(TimerId timerId) = 0;
+    // Called once the timer service is running and before the first tick,
+    // so strategies can arm their initial timers
+    virtual void onSessionStart() {}
     
+    void setTimerService(TimerService* service) { timers = service; }
     const std::string& getName() const { return name; }
-    double getCash() const { return cash; }
-    double getPosition(const std::string& symbol) const;
+    double getCash() const { return cash.toDouble(); }
+    Money getCashExact() const { return cash; }
+    int64_t getPosition(const std::string& symbol) const;
 };
 
 class MovingAverageCrossover : public Strategy {
 private:
     std::string symbol;
     int shortPeriod, longPeriod;
-    std::deque<double> prices;
-    double shortMA = 0.0, longMA = 0.0;
+    std::unique_ptr<IndicatorRegistry> ownRegistry; // Only set when no shared registry is given
+    IndicatorHandle shortMA, longMA;
+    uint64_t seenSequence = 0; // Registry updates of our symbol we have traded on
     bool prevCrossAbove = false;
     
-    void updateMovingAverages();
+    MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash,
+                           std::unique_ptr<IndicatorRegistry> registry);
     
 protected:
     // Make generateOrder virtual so it can be overridden in tests
-    virtual void generateOrder(const std::string& symbol, OrderType type, int quantity, double price) override;
+    virtual void generateOrder(const std::string& symbol, OrderType type, int quantity, Price price) override;
     
 public:
     MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash);
+    // Shares its moving averages through the registry. The registry must be
+    // advanced exactly once before each tick of the symbol reaches
+    // onMarketData (see dispatchTicks); a missed or repeated update throws.
+    MovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash,
+                           IndicatorRegistry& registry);
     
     void onMarketData(const MarketData& data) override;
     void onOrderFilled(const Order& order) override;
-    void onTimer() override;
+    void onTimer(TimerId timerId) override;
 };
 
+// Delivers count ticks to every strategy. Without a registry each strategy
+// gets the whole batch through onMarketDataBatch. With a shared registry,
+// ticks of subscribed symbols go out in lockstep: the registry is advanced and
+// that tick is handed to every strategy's onMarketData before the next, so
+// shared series always match the tick being processed. Runs of ticks between
+// them leave the registry untouched and go out through onMarketDataBatch.
+void dispatchTicks(IndicatorRegistry* registry, Strategy* const* strategies, size_t strategyCount,
+                   const MarketData* data, size_t count);
+
+// Backtest form of dispatchTicks that keeps the timer wheel on data time:
+// before each tick is dispatched the wheel is advanced to its timestamp,
+// firing whatever falls due in between, so timers scheduled from
+// onMarketData count from that tick. Consecutive ticks with the same
+// timestamp are dispatched together. The wheel must already be started.
+void dispatchTicksOnDataTime(TimerService& timers, IndicatorRegistry* registry, Strategy* const* strategies,
+                             size_t strategyCount, const MarketData* data, size_t count);
+
 #endif // STRATEGY_H
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include "tick_codec.h"
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+namespace {
+
+constexpr size_t MIN_TICK_BYTES = 6;  // One byte per field: symbol index and five deltas
+constexpr uint32_t BLOCK_MAGIC = 0x334B4254; // "TBK3"
+constexpr size_t HEADER_SIZE = 24;
+
+// Fixed block header, stored little-endian:
+//   magic u32 | tickCount u32 | payloadSize u32 | symbolCount u32 |
+//   firstTimestampNs i64
+// followed by the symbol table and the tick payload. Each symbol table entry
+// is a varint length, the symbol bytes and the symbol's tick value (varint
+// micro-units per tick) at the time of encoding.
+
+template<typename T>
+void putRaw(std::vector<uint8_t>& buf, T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+T getRaw(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+inline uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+inline void putVarint(std::vector<uint8_t>& buf, uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(v));
+}
+
+inline uint64_t getVarint(const uint8_t*& p, const uint8_t* end) {
+    // Most deltas fit in one byte; take that path without the loop
+    if (p < end && !(*p & 0x80)) {
+        return *p++;
+    }
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return result;
+    }
+    throw std::runtime_error("Tick stream corrupt: truncated varint");
+}
+
+inline int64_t toNanos(std::chrono::high_resolution_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+inline std::chrono::high_resolution_clock::time_point fromNanos(int64_t ns) {
+    return std::chrono::high_resolution_clock::time_point(
+        std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+// Decodes one block into a pre-sized range of MarketData slots.
+void decodeInto(const uint8_t* block, const TickBlockInfo& info, MarketData* dest) {
+    const uint8_t* end = block + info.size;
+    uint32_t symbolCount = getRaw<uint32_t>(block + 12);
+    int64_t timestamp = getRaw<int64_t>(block + 16);
+
+    struct SymbolState {
+        std::string symbol;
+        int64_t bid = 0, spread = 0, last = 0, volume = 0;
+        int64_t storedTickValue = 0, currentTickValue = 0;
+    };
+    std::vector<SymbolState> states(symbolCount);
+
+    const uint8_t* p = block + HEADER_SIZE;
+    for (auto& state : states) {
+        uint64_t len = getVarint(p, end);
+        if (len > static_cast<uint64_t>(end - p)) {
+            throw std::runtime_error("Tick stream corrupt: bad symbol table");
+        }
+        state.symbol.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+        state.storedTickValue = static_cast<int64_t>(getVarint(p, end));
+        state.currentTickValue = TickSizes::tickValue(state.symbol);
+        if (state.storedTickValue <= 0) {
+            throw std::runtime_error("Tick stream corrupt: bad tick value");
+        }
+    }
+
+    // Prices written under a different tick size are converted to the current
+    // one; a price that falls between the current ticks cannot be represented
+    auto rescale = [](const SymbolState& state, int64_t ticks) {
+        if (state.storedTickValue == state.currentTickValue) return Price(ticks);
+        int64_t micros = ticks * state.storedTickValue;
+        if (micros % state.currentTickValue != 0) {
+            throw std::runtime_error("Tick stream price for " + state.symbol +
+                                     " is not a whole number of the current tick size");
+        }
+        return Price(micros / state.currentTickValue);
+    };
+
+    for (uint32_t i = 0; i < info.tickCount; ++i) {
+        uint64_t symbolIdx = getVarint(p, end);
+        if (symbolIdx >= symbolCount) {
+            throw std::runtime_error("Tick stream corrupt: bad symbol index");
+        }
+        SymbolState& state = states[symbolIdx];
+        timestamp += unzigzag(getVarint(p, end));
+        state.bid += unzigzag(getVarint(p, end));
+        state.spread += unzigzag(getVarint(p, end));
+        state.last += unzigzag(getVarint(p, end));
+        state.volume += unzigzag(getVarint(p, end));
+
+        MarketData& tick = dest[i];
+        tick.symbol = state.symbol;
+        tick.bid = rescale(state, state.bid);
+        tick.ask = rescale(state, state.bid + state.spread);
+        tick.last = rescale(state, state.last);
+        tick.volume = state.volume;
+        tick.timestamp = fromNanos(timestamp);
+    }
+}
+
+} // namespace
+
+// TickEncoder implementation
+TickEncoder::TickEncoder(size_t blockSize) : ticksPerBlock(blockSize) {
+    if (ticksPerBlock == 0) {
+        throw std::invalid_argument("TickEncoder: block size must be positive");
+    }
+}
+
+void TickEncoder::append(const MarketData& data) {
+    int64_t timestamp = toNanos(data.timestamp);
+    if (blockTicks == 0) {
+        firstTimestampNs = timestamp;
+        prevTimestampNs = timestamp;
+    }
+
+    auto it = symbolStates.find(data.symbol);
+    if (it == symbolStates.end()) {
+        SymbolState state{static_cast<uint32_t>(blockSymbols.size()), 0, 0, 0, 0,
+                          TickSizes::tickValue(data.symbol)};
+        it = symbolStates.emplace(data.symbol, state).first;
+        blockSymbols.push_back(data.symbol);
+    }
+    SymbolState& state = it->second;
+
+    int64_t bid = data.bid.ticks();
+    int64_t spread = data.ask.ticks() - bid;
+    int64_t last = data.last.ticks();
+
+    putVarint(payload, state.index);
+    putVarint(payload, zigzag(timestamp - prevTimestampNs));
+    putVarint(payload, zigzag(bid - state.bid));
+    putVarint(payload, zigzag(spread - state.spread));
+    putVarint(payload, zigzag(last - state.last));
+    putVarint(payload, zigzag(data.volume - state.volume));
+
+    state.bid = bid;
+    state.spread = spread;
+    state.last = last;
+    state.volume = data.volume;
+    prevTimestampNs = timestamp;
+
+    if (++blockTicks >= ticksPerBlock) {
+        flush();
+    }
+}
+
+void TickEncoder::flush() {
+    if (blockTicks == 0) return;
+
+    size_t offset = out.size();
+    putRaw<uint32_t>(out, BLOCK_MAGIC);
+    putRaw<uint32_t>(out, blockTicks);
+    putRaw<uint32_t>(out, static_cast<uint32_t>(payload.size()));
+    putRaw<uint32_t>(out, static_cast<uint32_t>(blockSymbols.size()));
+    putRaw<int64_t>(out, firstTimestampNs);
+    for (const auto& symbol : blockSymbols) {
+        putVarint(out, symbol.size());
+        out.insert(out.end(), symbol.begin(), symbol.end());
+        putVarint(out, static_cast<uint64_t>(symbolStates[symbol].tickValue));
+    }
+    out.insert(out.end(), payload.begin(), payload.end());
+
+    blockIndex.push_back({offset, out.size() - offset, blockTicks, firstTimestampNs});
+
+    payload.clear();
+    blockSymbols.clear();
+    symbolStates.clear();
+    blockTicks = 0;
+}
+
+void TickEncoder::writeToFile(const std::string& filename) {
+    flush();
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open tick file for writing: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+}
+
+// TickDecoder implementation
+TickDecoder::TickDecoder(const uint8_t* buffer, size_t length) : data(buffer), size(length) {
+    size_t offset = 0;
+    while (offset < size) {
+        if (size - offset < HEADER_SIZE || getRaw<uint32_t>(data + offset) != BLOCK_MAGIC) {
+            throw std::runtime_error("Tick stream corrupt: bad block header");
+        }
+        const uint8_t* header = data + offset;
+        uint32_t tickCount = getRaw<uint32_t>(header + 4);
+        uint32_t payloadSize = getRaw<uint32_t>(header + 8);
+        uint32_t symbolCount = getRaw<uint32_t>(header + 12);
+
+        // Skip over the symbol table to find where the block ends
+        const uint8_t* p = header + HEADER_SIZE;
+        const uint8_t* end = data + size;
+        for (uint32_t i = 0; i < symbolCount; ++i) {
+            uint64_t len = getVarint(p, end);
+            if (len > static_cast<uint64_t>(end - p)) {
+                throw std::runtime_error("Tick stream corrupt: bad symbol table");
+            }
+            p += len;
+            getVarint(p, end); // Tick value
+        }
+        if (payloadSize > static_cast<size_t>(end - p)) {
+            throw std::runtime_error("Tick stream corrupt: truncated block");
+        }
+        // Checked here so a bad count can never size the output vectors
+        if (tickCount > payloadSize / MIN_TICK_BYTES) {
+            throw std::runtime_error("Tick stream corrupt: tick count exceeds payload");
+        }
+
+        size_t blockSize = static_cast<size_t>(p - header) + payloadSize;
+        blockIndex.push_back({offset, blockSize, tickCount, getRaw<int64_t>(header + 16)});
+        offset += blockSize;
+    }
+}
+
+size_t TickDecoder::tickCount() const {
+    size_t total = 0;
+    for (const auto& block : blockIndex) {
+        total += block.tickCount;
+    }
+    return total;
+}
+
+size_t TickDecoder::decodeBlock(size_t blockIdx, std::vector<MarketData>& out) const {
+    const TickBlockInfo& info = blockIndex.at(blockIdx);
+    // Resize from a prototype so the default constructor's clock read is paid
+    // once; slots left over from a previous block keep their string storage.
+    MarketData prototype;
+    out.resize(info.tickCount, prototype);
+    decodeInto(data + info.offset, info, out.data());
+    return info.tickCount;
+}
+
+size_t TickDecoder::findBlock(std::chrono::high_resolution_clock::time_point time) const {
+    int64_t target = toNanos(time);
+    auto it = std::upper_bound(blockIndex.begin(), blockIndex.end(), target,
+        [](int64_t t, const TickBlockInfo& block) { return t < block.firstTimestampNs; });
+    return it == blockIndex.begin() ? 0 : static_cast<size_t>(it - blockIndex.begin()) - 1;
+}
+
+void TickDecoder::decodeAll(std::vector<MarketData>& out, unsigned numThreads) const {
+    std::vector<size_t> starts(blockIndex.size());
+    size_t base = out.size();
+    size_t total = base;
+    for (size_t i = 0; i < blockIndex.size(); ++i) {
+        starts[i] = total;
+        total += blockIndex[i].tickCount;
+    }
+    MarketData prototype;
+    out.resize(total, prototype);
+
+    numThreads = std::max(1u, std::min<unsigned>(numThreads, static_cast<unsigned>(blockIndex.size())));
+    if (numThreads == 1) {
+        for (size_t i = 0; i < blockIndex.size(); ++i) {
+            decodeInto(data + blockIndex[i].offset, blockIndex[i], out.data() + starts[i]);
+        }
+        return;
+    }
+
+    // Blocks are interleaved across workers; each writes only its own slots
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(numThreads);
+    for (unsigned t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            try {
+                for (size_t i = t; i < blockIndex.size(); i += numThreads) {
+                    decodeInto(data + blockIndex[i].offset, blockIndex[i], out.data() + starts[i]);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+std::vector<uint8_t> TickDecoder::readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open tick file: " + filename);
+    }
+    std::vector<uint8_t> buffer(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!file || file.gcount() != static_cast<std::streamsize>(buffer.size())) {
+        throw std::runtime_error("Cannot read tick file: " + filename);
+    }
+    return buffer;
+}
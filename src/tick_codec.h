@@ -0,0 +1,95 @@
+#ifndef TICK_CODEC_H
+#define TICK_CODEC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include "market_data.h"
+
+// Compressed tick storage for history files and replay.
+//
+// Ticks are grouped into blocks that can be decoded independently of each
+// other, so replay can seek by timestamp and decode blocks in parallel.
+// Inside a block every field is stored as a zigzag varint:
+//   - timestamp: nanosecond delta from the previous tick in the block
+//   - bid:       tick delta from the previous bid of the same symbol
+//   - spread:    (ask - bid) in ticks, delta from the previous spread
+//   - last:      tick delta from the previous last of the same symbol
+//   - volume:    delta from the previous volume of the same symbol
+// Prices are stored in the instrument's ticks, so the round trip is exact.
+// Each block records every symbol's tick value; decoding under a different
+// TickSizes configuration rescales prices, or throws if a price is not a
+// whole number of the current tick.
+
+struct TickBlockInfo {
+    size_t offset;           // Byte offset of the block header in the stream
+    size_t size;             // Total block size in bytes, header included
+    uint32_t tickCount;
+    int64_t firstTimestampNs;
+};
+
+class TickEncoder {
+private:
+    struct SymbolState {
+        uint32_t index;
+        int64_t bid, spread, last, volume;
+        int64_t tickValue;  // Micro-units per tick when the block was written
+    };
+
+    size_t ticksPerBlock;
+    std::vector<uint8_t> out;
+    std::vector<TickBlockInfo> blockIndex;
+
+    // State of the block currently being built
+    std::vector<uint8_t> payload;
+    std::vector<std::string> blockSymbols;
+    std::unordered_map<std::string, SymbolState> symbolStates;
+    uint32_t blockTicks = 0;
+    int64_t firstTimestampNs = 0;
+    int64_t prevTimestampNs = 0;
+
+public:
+    explicit TickEncoder(size_t ticksPerBlock = 4096);
+
+    void append(const MarketData& data);
+    void flush();  // Close the current block; called implicitly by writeToFile
+
+    const std::vector<uint8_t>& buffer() const { return out; }
+    const std::vector<TickBlockInfo>& blocks() const { return blockIndex; }
+    void writeToFile(const std::string& filename);
+};
+
+class TickDecoder {
+private:
+    const uint8_t* data;
+    size_t size;
+    std::vector<TickBlockInfo> blockIndex;
+
+public:
+    // Non-owning view over an encoded stream; the buffer must outlive the decoder.
+    TickDecoder(const uint8_t* buffer, size_t length);
+    explicit TickDecoder(const std::vector<uint8_t>& buffer)
+        : TickDecoder(buffer.data(), buffer.size()) {}
+
+    size_t blockCount() const { return blockIndex.size(); }
+    const std::vector<TickBlockInfo>& blocks() const { return blockIndex; }
+    size_t tickCount() const;
+
+    // Replaces the contents of out with the ticks of one block and returns how
+    // many were decoded. Reusing the same vector across blocks avoids reallocation.
+    size_t decodeBlock(size_t blockIdx, std::vector<MarketData>& out) const;
+
+    // Index of the last block starting at or before the given time, so that
+    // decoding from it onwards yields every tick at or after that time.
+    size_t findBlock(std::chrono::high_resolution_clock::time_point time) const;
+
+    // Appends the whole stream to out in order, splitting the blocks across threads.
+    void decodeAll(std::vector<MarketData>& out, unsigned numThreads = 1) const;
+
+    static std::vector<uint8_t> readFile(const std::string& filename);
+};
+
+#endif // TICK_CODEC_H
@@ -0,0 +1,267 @@
+#include "timer_service.h"
+#include "strategy.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Index of the first set bit at or after from in a 256-bit slot bitmap, or -1
+int findOccupied(const uint64_t* bits, int from) {
+    for (int word = from >> 6; word < 4; ++word) {
+        uint64_t mask = bits[word];
+        if (word == (from >> 6)) {
+            mask &= ~uint64_t(0) << (from & 63);
+        }
+        if (mask) {
+            return (word << 6) + __builtin_ctzll(mask);
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+TimerService::TimerService(std::chrono::nanoseconds resolution, size_t initialCapacity)
+    : resolutionNs(resolution.count()) {
+    if (resolutionNs <= 0) {
+        throw std::invalid_argument("TimerService resolution must be positive");
+    }
+    for (int i = 0; i < LEVELS * SLOTS; ++i) {
+        slotHeads[i] = NIL;
+        slotTails[i] = NIL;
+    }
+    for (auto& word : occupied) {
+        word = 0;
+    }
+    nodes.reserve(initialCapacity);
+}
+
+int64_t TimerService::toStep(Clock::time_point time, bool roundUp) const {
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    int64_t step = ns / resolutionNs;
+    int64_t rem = ns % resolutionNs;
+    if (rem < 0) {
+        --step;  // Floor for times before the epoch
+        rem += resolutionNs;
+    }
+    return (roundUp && rem != 0) ? step + 1 : step;
+}
+
+void TimerService::start(Clock::time_point now) {
+    if (activeCount > 0) {
+        throw std::logic_error("TimerService cannot be restarted with timers pending");
+    }
+    currentStep = toStep(now, false);
+    started = true;
+}
+
+TimerService::Clock::time_point TimerService::now() const {
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(currentStep * resolutionNs)));
+}
+
+uint32_t TimerService::allocate() {
+    if (freeHead == NIL) {
+        // Grow the pool geometrically; existing indices stay valid
+        size_t oldSize = nodes.size();
+        size_t newSize = oldSize ? oldSize * 2 : std::max<size_t>(nodes.capacity(), 64);
+        if (newSize >= NIL) {
+            throw std::length_error("TimerService: too many outstanding timers");
+        }
+        nodes.resize(newSize);
+        for (size_t i = oldSize; i < newSize; ++i) {
+            nodes[i].next = (i + 1 < newSize) ? static_cast<uint32_t>(i + 1) : NIL;
+            nodes[i].generation = 1;
+            nodes[i].active = false;
+        }
+        freeHead = static_cast<uint32_t>(oldSize);
+    }
+    uint32_t index = freeHead;
+    freeHead = nodes[index].next;
+    return index;
+}
+
+void TimerService::release(uint32_t index) {
+    TimerNode& node = nodes[index];
+    node.active = false;
+    ++node.generation;
+    node.next = freeHead;
+    freeHead = index;
+    --activeCount;
+}
+
+void TimerService::insert(uint32_t index) {
+    TimerNode& node = nodes[index];
+
+    // Timers beyond the wheel's span park in the top level and are
+    // re-placed each time that slot cascades
+    const int64_t maxDelta = (int64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+    int64_t expiry = node.expiry;
+    if (expiry - currentStep > maxDelta) {
+        expiry = currentStep + maxDelta;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && expiry - currentStep >= (int64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    uint16_t slot = static_cast<uint16_t>(level * SLOTS + ((expiry >> (SLOT_BITS * level)) & (SLOTS - 1)));
+
+    node.slot = slot;
+    node.next = NIL;
+    node.prev = slotTails[slot];
+    if (slotTails[slot] != NIL) {
+        nodes[slotTails[slot]].next = index;
+    } else {
+        slotHeads[slot] = index;
+        occupied[slot >> 6] |= uint64_t(1) << (slot & 63);
+    }
+    slotTails[slot] = index;
+}
+
+void TimerService::unlink(uint32_t index) {
+    TimerNode& node = nodes[index];
+    uint16_t slot = node.slot;
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else {
+        slotHeads[slot] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    } else {
+        slotTails[slot] = node.prev;
+    }
+    if (slotHeads[slot] == NIL) {
+        occupied[slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+    }
+}
+
+TimerId TimerService::schedule(Strategy* target, std::chrono::nanoseconds delay) {
+    return scheduleAt(target, now() + std::chrono::duration_cast<Clock::duration>(delay));
+}
+
+TimerId TimerService::scheduleAt(Strategy* target, Clock::time_point when) {
+    if (!started) {
+        throw std::logic_error("TimerService must be started before scheduling");
+    }
+    uint32_t index = allocate();
+    TimerNode& node = nodes[index];
+    node.expiry = std::max(toStep(when, true), currentStep + 1);
+    node.target = target;
+    node.active = true;
+    insert(index);
+    ++activeCount;
+    return (static_cast<TimerId>(node.generation) << 32) | index;
+}
+
+bool TimerService::cancel(TimerId id) {
+    uint32_t index = static_cast<uint32_t>(id);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes.size() || !nodes[index].active || nodes[index].generation != generation) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+void TimerService::cascade(int level) {
+    uint16_t slot = static_cast<uint16_t>(level * SLOTS + ((currentStep >> (SLOT_BITS * level)) & (SLOTS - 1)));
+    uint32_t index = slotHeads[slot];
+    slotHeads[slot] = NIL;
+    slotTails[slot] = NIL;
+    occupied[slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+
+    // Detached first, so nodes re-placed into this same slot are not revisited
+    while (index != NIL) {
+        uint32_t next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+size_t TimerService::fireSlot(uint16_t slot) {
+    size_t fired = 0;
+    // Pop one at a time: callbacks may cancel or schedule other timers
+    while (slotHeads[slot] != NIL) {
+        uint32_t index = slotHeads[slot];
+        TimerNode& node = nodes[index];
+        Strategy* target = node.target;
+        TimerId id = (static_cast<TimerId>(node.generation) << 32) | index;
+        unlink(index);
+        release(index);
+        target->onTimer(id);
+        ++fired;
+    }
+    return fired;
+}
+
+size_t TimerService::advanceTo(Clock::time_point time) {
+    if (!started) {
+        throw std::logic_error("TimerService must be started before advancing");
+    }
+
+    int64_t target = toStep(time, false);
+    size_t fired = 0;
+    while (currentStep < target) {
+        if (activeCount == 0) {
+            currentStep = target;
+            break;
+        }
+
+        // Jump straight to the next occupied slot in this level-0 rotation
+        int index = static_cast<int>(currentStep & (SLOTS - 1));
+        int next = index + 1 < SLOTS ? findOccupied(occupied, index + 1) : -1;
+        if (next >= 0) {
+            int64_t step = currentStep - index + next;
+            if (step > target) {
+                currentStep = target;
+                break;
+            }
+            currentStep = step;
+            fired += fireSlot(static_cast<uint16_t>(next));
+            continue;
+        }
+
+        // Otherwise move to the next rotation, pulling down from higher levels
+        int64_t step = (currentStep | (SLOTS - 1)) + 1;
+        if (step > target) {
+            currentStep = target;
+            break;
+        }
+        currentStep = step;
+        for (int level = LEVELS - 1; level > 0; --level) {
+            if ((currentStep & ((int64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        fired += fireSlot(0);
+    }
+    return fired;
+}
+
+int64_t TimerService::nextStepBound() const {
+    if (activeCount == 0) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    int index = static_cast<int>(currentStep & (SLOTS - 1));
+    int next = index + 1 < SLOTS ? findOccupied(occupied, index + 1) : -1;
+    if (next >= 0) {
+        return currentStep - index + next;
+    }
+    return (currentStep | (SLOTS - 1)) + 1;
+}
+
+TimerService::Clock::time_point TimerService::nextDue() const {
+    if (!started || activeCount == 0) {
+        return Clock::time_point::max();
+    }
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(nextStepBound() * resolutionNs)));
+}
+
+bool TimerService::hasDue(Clock::time_point time) const {
+    return started && toStep(time, false) >= nextStepBound();
+}
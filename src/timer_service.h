@@ -0,0 +1,95 @@
+#ifndef TIMER_SERVICE_H
+#define TIMER_SERVICE_H
+
+#include <cstdint>
+#include <vector>
+#include <chrono>
+
+class Strategy;
+
+// Identifies a scheduled timer. Ids stay unique after the timer fires or is
+// cancelled, so cancelling a stale id is a harmless no-op.
+using TimerId = uint64_t;
+
+// Timer service built on a hierarchical timing wheel: four levels of 256
+// slots, each level covering 256 times the span of the one below. Schedule
+// and cancel are O(1); timers live in a pooled array linked by index, so
+// outstanding timers cost no heap allocation of their own.
+//
+// Time only moves when advanceTo() is called: with wall-clock time in live
+// trading, with tick timestamps in backtests. Timers fire in order of their
+// expiry step; timers sharing a step fire together. Not thread-safe: drive it
+// from the trading loop.
+class TimerService {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr uint32_t NIL = 0xFFFFFFFF;
+
+    struct TimerNode {
+        int64_t expiry;      // In resolution steps
+        Strategy* target;
+        uint32_t next, prev; // Slot list links, or free list link in next
+        uint32_t generation;
+        uint16_t slot;       // Index into slotHeads while scheduled
+        bool active;
+    };
+
+    int64_t resolutionNs;
+    int64_t currentStep = 0;
+    bool started = false;
+    size_t activeCount = 0;
+
+    std::vector<TimerNode> nodes;
+    uint32_t freeHead = NIL;
+    uint32_t slotHeads[LEVELS * SLOTS];
+    uint32_t slotTails[LEVELS * SLOTS];
+    uint64_t occupied[LEVELS * SLOTS / 64]; // One bit per non-empty slot
+
+    int64_t toStep(Clock::time_point time, bool roundUp) const;
+    uint32_t allocate();
+    void release(uint32_t index);
+    void insert(uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(int level);
+    size_t fireSlot(uint16_t slot);
+    int64_t nextStepBound() const;
+
+public:
+    explicit TimerService(std::chrono::nanoseconds resolution = std::chrono::milliseconds(1),
+                          size_t initialCapacity = 1024);
+
+    // Sets the wheel's notion of "now"; must be called before scheduling or
+    // advancing, so start it before the first tick is delivered.
+    void start(Clock::time_point now);
+    bool isStarted() const { return started; }
+    Clock::time_point now() const;
+
+    // Fires target->onTimer(id) once time reaches now() + delay, rounded up to
+    // the resolution and never sooner than the next step.
+    TimerId schedule(Strategy* target, std::chrono::nanoseconds delay);
+    TimerId scheduleAt(Strategy* target, Clock::time_point when);
+    bool cancel(TimerId id);
+
+    // Fires every timer due at or before time, in expiry order, and returns
+    // how many fired. Moving backwards is a no-op.
+    size_t advanceTo(Clock::time_point time);
+
+    // True if advancing to time would fire at least one timer. May report
+    // true slightly early (at wheel rotation boundaries), never late, so
+    // callers can deliver everything before time in one batch when false.
+    bool hasDue(Clock::time_point time) const;
+
+    // Earliest time at which advanceTo() could fire a timer, with the same
+    // early-never-late guarantee as hasDue(); time_point::max() when idle.
+    // Live loops use it to bound how long they wait for market data.
+    Clock::time_point nextDue() const;
+
+    size_t pending() const { return activeCount; }
+};
+
+#endif // TIMER_SERVICE_H
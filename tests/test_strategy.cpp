@@ -3,11 +3,19 @@
 #include <vector>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include "../src/strategy.h"
 #include "../src/market_data.h"
 #include "../src/portfolio.h"
 #include "../src/risk_manager.h"
 #include "../src/order_manager.h"
+#include "../src/tick_codec.h"
+#include "../src/indicator.h"
+#include "../src/timer_service.h"
+#include "../src/itch_feed.h"
+#include "../src/order_gateway.h"
 
 // Simple test framework
 class TestFramework {
@@ -56,8 +64,12 @@ public:
     TestableMovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash)
         : MovingAverageCrossover(sym, shortP, longP, initialCash) {}
     
+    TestableMovingAverageCrossover(const std::string& sym, int shortP, int longP, double initialCash,
+                                   IndicatorRegistry& registry)
+        : MovingAverageCrossover(sym, shortP, longP, initialCash, registry) {}
+    
 protected:
-    void generateOrder(const std::string& symbol, OrderType type, int quantity, double price) override {
+    void generateOrder(const std::string& symbol, OrderType type, int quantity, Price price) override {
         // Capture the order instead of just printing
         static int orderId = 1;
         Order order(orderId++, symbol, type, quantity, price);
@@ -65,7 +77,7 @@ protected:
         
         std::cout << "📋 Captured Order: " << symbol 
                   << (type == OrderType::BUY ? " BUY " : " SELL ")
-                  << quantity << " @ $" << std::fixed << std::setprecision(2) << price << std::endl;
+                  << quantity << " @ $" << std::fixed << std::setprecision(2) << price.toDouble(symbol) << std::endl;
     }
 };
 
@@ -138,15 +150,15 @@ void testMarketData(TestFramework& tf) {
     std::cout << "\n🧪 Testing MarketData class..." << std::endl;
     
     MarketData data1("AAPL", 150.0, 150.5, 150.25, 1000000);
-    tf.assert_equal(150.0, data1.bid, 0.001, "MarketData bid price");
-    tf.assert_equal(150.5, data1.ask, 0.001, "MarketData ask price");
-    tf.assert_equal(150.25, data1.last, 0.001, "MarketData last price");
+    tf.assert_equal(150.0, data1.bid.toDouble("AAPL"), 0.001, "MarketData bid price");
+    tf.assert_equal(150.5, data1.ask.toDouble("AAPL"), 0.001, "MarketData ask price");
+    tf.assert_equal(150.25, data1.last.toDouble("AAPL"), 0.001, "MarketData last price");
     tf.assert_true(data1.symbol == "AAPL", "MarketData symbol");
     tf.assert_true(data1.volume == 1000000, "MarketData volume");
     
     MarketData data2; // Default constructor
     tf.assert_true(data2.symbol.empty(), "Default MarketData should have empty symbol");
-    tf.assert_equal(0.0, data2.bid, 0.001, "Default MarketData bid should be 0");
+    tf.assert_true(data2.bid == Price(), "Default MarketData bid should be 0");
 }
 
 void testPortfolio(TestFramework& tf) {
@@ -201,7 +213,35 @@ void testOrderManager(TestFramework& tf) {
     tf.assert_true(retrievedOrder.symbol == "AAPL", "Retrieved order should have correct symbol");
     tf.assert_true(retrievedOrder.type == OrderType::BUY, "Retrieved order should have correct type");
     tf.assert_equal(100, retrievedOrder.quantity, 0.001, "Retrieved order should have correct quantity");
-    tf.assert_equal(150.0, retrievedOrder.price, 0.001, "Retrieved order should have correct price");
+    tf.assert_equal(150.0, retrievedOrder.price.toDouble("AAPL"), 0.001, "Retrieved order should have correct price");
+    
+    // Completed orders are retired once newer ids wrap onto their slots
+    OrderManager small(4);
+    std::vector<int> ids;
+    for (int i = 0; i < 4; i++) {
+        ids.push_back(small.submitOrder("AAPL", OrderType::BUY, 100, 150.0));
+    }
+    bool threw = false;
+    try {
+        small.submitOrder("AAPL", OrderType::BUY, 100, 150.0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "An open order should not be retired to make room");
+    small.updateOrderStatus(ids[0], OrderStatus::FILLED);
+    small.updateOrderStatus(ids[1], OrderStatus::FILLED);
+    int newer = small.submitOrder("MSFT", OrderType::SELL, 10, 300.0);
+    tf.assert_true(small.getOrderStatus(newer) == OrderStatus::PENDING && small.getOrder(newer).symbol == "MSFT",
+                   "Order should take over a completed order's slot");
+    threw = false;
+    try {
+        small.getOrderStatus(ids[1]);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Retired order should no longer be found");
+    small.updateOrderStatus(ids[1], OrderStatus::CANCELLED);
+    tf.assert_true(small.getOrderStatus(newer) == OrderStatus::PENDING, "Updates for retired ids should be ignored");
 }
 
 void testOrderClass(TestFramework& tf) {
@@ -213,7 +253,7 @@ void testOrderClass(TestFramework& tf) {
     tf.assert_true(order1.symbol == "AAPL", "Order symbol should be AAPL");
     tf.assert_true(order1.type == OrderType::BUY, "Order type should be BUY");
     tf.assert_equal(100, order1.quantity, 0.001, "Order quantity should be 100");
-    tf.assert_equal(150.0, order1.price, 0.001, "Order price should be 150.0");
+    tf.assert_equal(150.0, order1.price.toDouble("AAPL"), 0.001, "Order price should be 150.0");
     
     // Test default constructor
     Order order2;
@@ -222,6 +262,689 @@ void testOrderClass(TestFramework& tf) {
     tf.assert_true(order2.type == OrderType::BUY, "Default order type should be BUY");
 }
 
+void testTickCodec(TestFramework& tf) {
+    std::cout << "\n🧪 Testing TickEncoder/TickDecoder..." << std::endl;
+    
+    // Prices on a 0.01 grid with a few symbols interleaved
+    std::vector<MarketData> ticks;
+    const char* symbols[] = {"AAPL", "GOOGL", "MSFT"};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 1000; i++) {
+        int cents = 15000 + (i % 37) * 3 - (i % 11) * 5;
+        MarketData tick(symbols[i % 3], (cents - 1) / 100.0, (cents + 2) / 100.0, cents / 100.0, 1000000 - i * 7);
+        tick.timestamp = start + std::chrono::microseconds(i * 250 + (i % 5));
+        ticks.push_back(tick);
+    }
+    
+    TickEncoder encoder(128); // Small blocks to exercise block boundaries
+    for (const auto& tick : ticks) {
+        encoder.append(tick);
+    }
+    encoder.flush();
+    
+    TickDecoder decoder(encoder.buffer());
+    tf.assert_true(decoder.blockCount() == 8, "1000 ticks at 128 per block should give 8 blocks");
+    tf.assert_true(decoder.tickCount() == ticks.size(), "Decoder should report every encoded tick");
+    
+    std::vector<MarketData> decoded;
+    decoder.decodeAll(decoded);
+    bool exact = decoded.size() == ticks.size();
+    for (size_t i = 0; exact && i < ticks.size(); i++) {
+        exact = decoded[i].symbol == ticks[i].symbol && decoded[i].bid == ticks[i].bid &&
+                decoded[i].ask == ticks[i].ask && decoded[i].last == ticks[i].last &&
+                decoded[i].volume == ticks[i].volume && decoded[i].timestamp == ticks[i].timestamp;
+    }
+    tf.assert_true(exact, "Round trip should reproduce every tick exactly");
+    
+    std::vector<MarketData> parallel;
+    decoder.decodeAll(parallel, 4);
+    bool same = parallel.size() == decoded.size();
+    for (size_t i = 0; same && i < decoded.size(); i++) {
+        same = parallel[i].symbol == decoded[i].symbol && parallel[i].last == decoded[i].last &&
+               parallel[i].timestamp == decoded[i].timestamp;
+    }
+    tf.assert_true(same, "Parallel decode should match sequential decode");
+    
+    // Seeking to the middle of block 3 should land on block 3
+    size_t blockIdx = decoder.findBlock(ticks[3 * 128 + 50].timestamp);
+    tf.assert_true(blockIdx == 3, "findBlock should return the block containing the timestamp");
+    std::vector<MarketData> block;
+    tf.assert_true(decoder.decodeBlock(blockIdx, block) == 128, "A full block should decode 128 ticks");
+    tf.assert_true(block.front().timestamp == ticks[3 * 128].timestamp, "Block should start at its first tick");
+    
+    tf.assert_true(encoder.buffer().size() < ticks.size() * (sizeof(double) * 3 + sizeof(int64_t) * 2) / 2,
+                   "Encoded stream should be under half the raw field size");
+    
+    std::vector<uint8_t> corrupt(encoder.buffer().begin(), encoder.buffer().begin() + 40);
+    bool threw = false;
+    try {
+        TickDecoder bad(corrupt);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Truncated stream should be rejected");
+    
+    // A header claiming more ticks than its payload can hold must fail up front
+    std::vector<uint8_t> inflated(encoder.buffer().begin(), encoder.buffer().begin() + decoder.blocks()[0].size);
+    uint32_t hugeCount = 0xFFFFFFF0;
+    std::memcpy(inflated.data() + 4, &hugeCount, sizeof(hugeCount));
+    threw = false;
+    try {
+        TickDecoder bad(inflated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Tick count larger than the payload should be rejected");
+    
+    threw = false;
+    try {
+        TickDecoder::readFile("no_such_tick_file.bin");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Missing tick file should be reported");
+    
+    // History written under one tick size and read back under another
+    TickSizes::set("TICKRS", 0.01);
+    TickEncoder history;
+    history.append(MarketData("TICKRS", 150.05, 150.07, 150.06, 500));
+    history.flush();
+    TickSizes::set("TICKRS", 0.001);
+    std::vector<MarketData> finer;
+    TickDecoder(history.buffer()).decodeAll(finer);
+    tf.assert_true(finer.size() == 1 && finer[0].bid == Price(150050) && finer[0].last == Price(150060),
+                   "Prices should be rescaled to a finer tick size");
+    tf.assert_equal(150.07, finer.empty() ? 0.0 : finer[0].ask.toDouble("TICKRS"), 1e-9,
+                    "Rescaled prices should keep their value");
+    TickSizes::set("TICKRS", 0.05);
+    threw = false;
+    try {
+        std::vector<MarketData> coarser;
+        TickDecoder(history.buffer()).decodeAll(coarser);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Prices off the current tick grid should be rejected");
+    TickSizes::set("TICKRS", 0.01);
+}
+
+void testIndicatorRegistry(TestFramework& tf) {
+    std::cout << "\n🧪 Testing IndicatorRegistry..." << std::endl;
+    
+    IndicatorRegistry registry;
+    IndicatorHandle sma3 = registry.subscribe("AAPL", IndicatorType::SMA, 3);
+    {
+        IndicatorHandle sma3Again = registry.subscribe("AAPL", IndicatorType::SMA, 3);
+        IndicatorHandle sma5 = registry.subscribe("AAPL", IndicatorType::SMA, 5);
+        tf.assert_true(registry.indicatorCount() == 2, "Same key should share one indicator");
+        
+        double prices[] = {10.0, 11.0, 12.0, 13.0, 14.0, 15.0};
+        for (double price : prices) {
+            registry.onMarketData(MarketData("AAPL", price, price, price, 100));
+            registry.onMarketData(MarketData("MSFT", 1.0, 1.0, 1.0, 100)); // No subscribers
+        }
+        tf.assert_true(sma3Again.ready() && sma5.ready(), "Both averages should be ready after 6 ticks");
+        tf.assert_equal(14.0, sma3.value(), 0.001, "SMA(3) of 13,14,15");
+        tf.assert_equal(14.0, sma3Again.value(), 0.001, "Shared handle sees the same SMA(3)");
+        tf.assert_equal(13.0, sma5.value(), 0.001, "SMA(5) of 11..15");
+        tf.assert_true(registry.windowSize("AAPL") == 6, "Window should hold longest period + 1");
+        tf.assert_true(registry.windowSize("MSFT") == 0, "Unsubscribed symbols should keep no window");
+    }
+    tf.assert_true(registry.indicatorCount() == 1, "Unused SMA(5) should be torn down");
+    tf.assert_true(registry.windowSize("AAPL") == 4, "Window should shrink to SMA(3) needs");
+    
+    // A late subscriber is seeded from the shared window
+    IndicatorHandle lateSma2 = registry.subscribe("AAPL", IndicatorType::SMA, 2);
+    tf.assert_equal(14.5, lateSma2.value(), 0.001, "Late SMA(2) should be seeded from history");
+    
+    sma3 = IndicatorHandle();
+    lateSma2 = IndicatorHandle();
+    tf.assert_true(registry.indicatorCount() == 0, "Registry should be empty once all handles are gone");
+    
+    // Strategies sharing a registry should behave exactly like standalone ones
+    IndicatorRegistry shared;
+    TestableMovingAverageCrossover standalone("AAPL", 5, 10, 100000.0);
+    TestableMovingAverageCrossover sharedA("AAPL", 5, 10, 100000.0, shared);
+    TestableMovingAverageCrossover sharedB("AAPL", 5, 10, 100000.0, shared);
+    tf.assert_true(shared.indicatorCount() == 2, "Two identical strategies should share two indicators");
+    for (const auto& data : generateTestData()) {
+        standalone.onMarketData(data);
+        shared.onMarketData(data);
+        sharedA.onMarketData(data);
+        sharedB.onMarketData(data);
+    }
+    bool sameOrders = !standalone.generatedOrders.empty() &&
+                      sharedA.generatedOrders.size() == standalone.generatedOrders.size() &&
+                      sharedB.generatedOrders.size() == standalone.generatedOrders.size();
+    for (size_t i = 0; sameOrders && i < standalone.generatedOrders.size(); i++) {
+        sameOrders = sharedA.generatedOrders[i].type == standalone.generatedOrders[i].type &&
+                     sharedB.generatedOrders[i].type == standalone.generatedOrders[i].type;
+    }
+    tf.assert_true(sameOrders, "Shared-registry strategies should generate the same orders");
+    
+    // Averages closer than a double can resolve still compare exactly
+    TickSizes::set("EXACT", 0.000001);
+    IndicatorRegistry exactRegistry;
+    IndicatorHandle exact3 = exactRegistry.subscribe("EXACT", IndicatorType::SMA, 3);
+    IndicatorHandle exact4 = exactRegistry.subscribe("EXACT", IndicatorType::SMA, 4);
+    const int64_t big = int64_t(1) << 52;
+    for (int64_t ticks : {big, big, big, big + 1}) {
+        exactRegistry.onMarketData(MarketData("EXACT", Price(ticks), Price(ticks), Price(ticks), 100,
+                                              std::chrono::high_resolution_clock::now()));
+    }
+    tf.assert_true(exact3.compare(exact4) > 0 && exact4.compare(exact3) < 0,
+                   "SMA(3) of N,N,N+1 should exceed SMA(4) of N,N,N,N+1");
+    tf.assert_true(exact3.compare(exact3) == 0, "An average should compare equal to itself");
+}
+
+void testFixedPointPrice(TestFramework& tf) {
+    std::cout << "\n🧪 Testing fixed-point Price and Money..." << std::endl;
+    
+    TickSizes::set("ES", 0.25);
+    TickSizes::set("EURUSD", 0.00001);
+    
+    Price aapl = Price::fromDouble("AAPL", 150.25);
+    tf.assert_true(aapl.ticks() == 15025, "AAPL uses the default 0.01 tick");
+    tf.assert_true(Price::fromDouble("ES", 4500.75).ticks() == 18003, "ES should count quarter-point ticks");
+    tf.assert_true(Price::fromDouble("EURUSD", 1.08345).ticks() == 108345, "EURUSD should count 0.00001 ticks");
+    tf.assert_true(Price(18003).toDouble("ES") == 4500.75, "ES ticks should convert back exactly");
+    tf.assert_true(Price::fromDouble("AAPL", 0.1) + Price::fromDouble("AAPL", 0.2) == Price::fromDouble("AAPL", 0.3),
+                   "0.1 + 0.2 should equal 0.3 in ticks");
+    tf.assert_true(std::hash<Price>()(aapl) == std::hash<int64_t>()(15025), "Price should hash as its tick count");
+    tf.assert_true(TickSizes::notional("ES", Price(18003), 2) == Money::fromDouble(9001.5),
+                   "Notional should be exact integer arithmetic");
+    
+    // Ten buys at a price that is not representable in binary, then sell all
+    Portfolio portfolio(100000.0);
+    for (int i = 0; i < 10; i++) {
+        portfolio.updatePosition("AAPL", 3, Price::fromDouble("AAPL", 100.10));
+    }
+    portfolio.updatePosition("AAPL", -30, Price::fromDouble("AAPL", 100.10));
+    tf.assert_true(portfolio.getCashExact() == Money::fromDouble(100000.0), "Cash should return exactly to the start");
+    tf.assert_true(portfolio.getRealizedPnL() == Money(), "Flat round trip should realize exactly zero");
+    
+    // Partial closes with an uneven average cost still conserve value exactly
+    portfolio.updatePosition("AAPL", 3, Price::fromDouble("AAPL", 10.00));
+    portfolio.updatePosition("AAPL", 4, Price::fromDouble("AAPL", 10.01));
+    portfolio.updatePosition("AAPL", -5, Price::fromDouble("AAPL", 10.05));
+    portfolio.updatePosition("AAPL", -2, Price::fromDouble("AAPL", 10.05));
+    tf.assert_true(portfolio.getPosition("AAPL") == 0, "Position should be flat");
+    tf.assert_true(portfolio.getRealizedPnL() == Money::fromDouble(0.31), "Realized P&L should be exactly $0.31");
+    tf.assert_true(portfolio.getCashExact() == Money::fromDouble(100000.31), "Cash should include the P&L exactly");
+    
+    // Selling through zero opens a short at the trade price
+    portfolio.updatePosition("AAPL", 10, Price::fromDouble("AAPL", 50.00));
+    portfolio.updatePosition("AAPL", -15, Price::fromDouble("AAPL", 51.00));
+    tf.assert_true(portfolio.getPosition("AAPL") == -5, "Position should flip to -5");
+    std::unordered_map<std::string, Price> prices = {{"AAPL", Price::fromDouble("AAPL", 50.00)}};
+    tf.assert_true(portfolio.getUnrealizedPnL(prices) == Money::fromDouble(5.0), "Short from 51 marked at 50 is +$5");
+    
+    RiskManager riskManager(4500.0, 5000.0);
+    tf.assert_true(riskManager.validateOrder(Order(1, "ES", OrderType::BUY, 1, 4500.0), 0),
+                   "Exactly at the position limit should be approved");
+    tf.assert_true(!riskManager.validateOrder(Order(2, "ES", OrderType::BUY, 1, 4500.25), 0),
+                   "One tick over the limit should be rejected");
+}
+
+// Minimal feed that only toggles the running flag
+class ManualDataFeed : public DataFeed {
+public:
+    void subscribe(const std::string&) override {}
+    void start() override { running = true; }
+    void stop() override { running = false; }
+};
+
+void testBatchDelivery(TestFramework& tf) {
+    std::cout << "\n🧪 Testing batched tick delivery..." << std::endl;
+    
+    std::vector<MarketData> testData = generateTestData();
+    ManualDataFeed feed;
+    feed.start();
+    feed.addBatch(testData.data(), 10);
+    feed.addData(testData[10]);
+    
+    std::vector<MarketData> batch(4);
+    size_t count = feed.getNextBatch(batch.data(), batch.size());
+    tf.assert_true(count == 4, "Batch should be capped at the caller's capacity");
+    tf.assert_true(batch[0].last == testData[0].last && batch[3].last == testData[3].last,
+                   "Batch should preserve arrival order");
+    
+    std::vector<MarketData> rest(16);
+    count = feed.getNextBatch(rest.data(), rest.size());
+    tf.assert_true(count == 7, "Second batch should drain the remaining 7 ticks");
+    tf.assert_true(rest[6].last == testData[10].last, "Last tick should be the one added individually");
+    
+    feed.stop();
+    tf.assert_true(feed.getNextBatch(rest.data(), rest.size()) == 0, "Stopped empty feed should return no ticks");
+    
+    // Default batch hook should behave exactly like per-tick delivery
+    TestableMovingAverageCrossover perTick("AAPL", 5, 10, 100000.0);
+    TestableMovingAverageCrossover batched("AAPL", 5, 10, 100000.0);
+    for (const auto& data : testData) {
+        perTick.onMarketData(data);
+    }
+    for (size_t i = 0; i < testData.size(); i += 7) {
+        batched.onMarketDataBatch(testData.data() + i, std::min<size_t>(7, testData.size() - i));
+    }
+    bool sameOrders = !perTick.generatedOrders.empty() &&
+                      perTick.generatedOrders.size() == batched.generatedOrders.size();
+    for (size_t i = 0; sameOrders && i < perTick.generatedOrders.size(); i++) {
+        sameOrders = perTick.generatedOrders[i].type == batched.generatedOrders[i].type &&
+                     perTick.generatedOrders[i].price == batched.generatedOrders[i].price;
+    }
+    tf.assert_true(sameOrders, "Batched delivery should generate the same orders as per-tick delivery");
+    
+    // Strategies sharing a registry take batches through dispatchTicks
+    IndicatorRegistry shared;
+    TestableMovingAverageCrossover sharedA("AAPL", 5, 10, 100000.0, shared);
+    TestableMovingAverageCrossover sharedB("AAPL", 5, 10, 100000.0, shared);
+    Strategy* strategies[] = {&sharedA, &sharedB};
+    for (size_t i = 0; i < testData.size(); i += 7) {
+        dispatchTicks(&shared, strategies, 2, testData.data() + i, std::min<size_t>(7, testData.size() - i));
+    }
+    sameOrders = sharedA.generatedOrders.size() == perTick.generatedOrders.size() &&
+                 sharedB.generatedOrders.size() == perTick.generatedOrders.size();
+    for (size_t i = 0; sameOrders && i < perTick.generatedOrders.size(); i++) {
+        sameOrders = sharedA.generatedOrders[i].type == perTick.generatedOrders[i].type &&
+                     sharedA.generatedOrders[i].price == perTick.generatedOrders[i].price &&
+                     sharedB.generatedOrders[i].type == perTick.generatedOrders[i].type &&
+                     sharedB.generatedOrders[i].price == perTick.generatedOrders[i].price;
+    }
+    tf.assert_true(sameOrders, "Shared-registry strategies fed in batches should match per-tick delivery");
+    
+    // Handing a shared-registry strategy a batch directly must not go unnoticed
+    IndicatorRegistry skipped;
+    TestableMovingAverageCrossover misfed("AAPL", 5, 10, 100000.0, skipped);
+    for (size_t i = 0; i < 7; i++) {
+        skipped.onMarketData(testData[i]);
+    }
+    bool threw = false;
+    try {
+        misfed.onMarketDataBatch(testData.data(), 7);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Batch delivery that bypasses the shared registry should throw");
+    
+    // The same tick delivered twice is caught even though its contents match
+    IndicatorRegistry repeated;
+    TestableMovingAverageCrossover twice("AAPL", 5, 10, 100000.0, repeated);
+    Strategy* twiceStrategies[] = {&twice};
+    dispatchTicks(&repeated, twiceStrategies, 1, testData.data(), 1);
+    threw = false;
+    try {
+        twice.onMarketData(testData[0]);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Redelivering a tick the registry has not advanced for should throw");
+    
+    // Ticks no indicator is subscribed to reach strategies as batches
+    class BatchCountingStrategy : public Strategy {
+    public:
+        std::vector<size_t> batchSizes;
+        size_t singleTicks = 0;
+        BatchCountingStrategy() : Strategy("BatchCounting", 0.0) {}
+        void onMarketData(const MarketData&) override { ++singleTicks; }
+        void onMarketDataBatch(const MarketData*, size_t count) override { batchSizes.push_back(count); }
+        void onOrderFilled(const Order&) override {}
+        void onTimer(TimerId) override {}
+    };
+    IndicatorRegistry mixedRegistry;
+    TestableMovingAverageCrossover aaplOnly("AAPL", 2, 3, 100000.0, mixedRegistry);
+    BatchCountingStrategy counter;
+    Strategy* mixedStrategies[] = {&aaplOnly, &counter};
+    std::vector<MarketData> mixed = {
+        MarketData("MSFT", 300.0, 300.02, 300.01, 100), MarketData("MSFT", 300.0, 300.02, 300.01, 100),
+        MarketData("AAPL", 150.0, 150.02, 150.01, 100), MarketData("MSFT", 300.0, 300.02, 300.01, 100),
+        MarketData("GOOG", 140.0, 140.02, 140.01, 100), MarketData("MSFT", 300.0, 300.02, 300.01, 100),
+    };
+    dispatchTicks(&mixedRegistry, mixedStrategies, 2, mixed.data(), mixed.size());
+    tf.assert_true(counter.singleTicks == 1, "Only the subscribed tick should go out one at a time");
+    tf.assert_true(counter.batchSizes == std::vector<size_t>({2, 3}),
+                   "Unsubscribed ticks on either side of it should arrive as two batches");
+    tf.assert_true(mixedRegistry.windowSize("AAPL") == 1, "Registry should advance only for the subscribed tick");
+}
+
+// Records timer callbacks and optionally reschedules or cancels from inside them
+class TimerRecordingStrategy : public Strategy {
+public:
+    std::vector<TimerId> firedIds;
+    std::vector<TimerService::Clock::time_point> firedAt;
+    TimerId cancelOnFire = 0;
+    int reschedules = 0;
+    
+    TimerRecordingStrategy() : Strategy("TimerRecorder", 0.0) {}
+    TimerService* service() { return timers; }
+    void onMarketData(const MarketData&) override {}
+    void onOrderFilled(const Order&) override {}
+    void onTimer(TimerId timerId) override {
+        firedIds.push_back(timerId);
+        firedAt.push_back(timers->now());
+        if (cancelOnFire) {
+            timers->cancel(cancelOnFire);
+            cancelOnFire = 0;
+        }
+        if (reschedules > 0) {
+            --reschedules;
+            timers->schedule(this, std::chrono::milliseconds(10)); // Periodic timer
+        }
+    }
+};
+
+void testTimerService(TestFramework& tf) {
+    std::cout << "\n🧪 Testing TimerService..." << std::endl;
+    using namespace std::chrono;
+    
+    TimerService timers(milliseconds(1), 16);
+    TimerRecordingStrategy strategy;
+    strategy.setTimerService(&timers);
+    auto t0 = TimerService::Clock::time_point(duration_cast<TimerService::Clock::duration>(hours(24 * 365 * 50)));
+    timers.start(t0);
+    
+    TimerId late = timers.schedule(&strategy, milliseconds(300));
+    TimerId early = timers.schedule(&strategy, milliseconds(5));
+    TimerId far = timers.schedule(&strategy, hours(30)); // Beyond level 2
+    TimerId cancelled = timers.schedule(&strategy, milliseconds(100));
+    tf.assert_true(timers.pending() == 4, "Four timers should be pending");
+    tf.assert_true(timers.cancel(cancelled), "Pending timer should cancel");
+    tf.assert_true(!timers.cancel(cancelled), "Cancelling twice should be a no-op");
+    
+    tf.assert_true(!timers.hasDue(t0 + milliseconds(4)), "Nothing should be due before 5ms");
+    tf.assert_true(timers.hasDue(t0 + milliseconds(5)), "The 5ms timer should be due at 5ms");
+    tf.assert_true(timers.advanceTo(t0 + milliseconds(4)) == 0, "No timer should fire before 5ms");
+    tf.assert_true(timers.advanceTo(t0 + seconds(1)) == 2, "5ms and 300ms timers should fire by 1s");
+    tf.assert_true(strategy.firedIds.size() == 2 && strategy.firedIds[0] == early && strategy.firedIds[1] == late,
+                   "Timers should fire in expiry order");
+    tf.assert_true(strategy.firedAt.size() == 2 && strategy.firedAt[1] == t0 + milliseconds(300),
+                   "Service time should equal the expiry while firing");
+    tf.assert_true(!timers.cancel(early), "Fired timer id should not cancel a reused slot");
+    
+    // Crossing level boundaries: the 30h timer must not fire early
+    tf.assert_true(timers.advanceTo(t0 + hours(30) - milliseconds(1)) == 0, "30h timer should not fire early");
+    tf.assert_true(timers.advanceTo(t0 + hours(30)) == 1 && strategy.firedIds.back() == far,
+                   "30h timer should fire exactly at 30h");
+    
+    // Timers beyond the wheel span (2^32 steps) are re-placed until due
+    TimerService coarse(milliseconds(1));
+    coarse.start(t0);
+    TimerId veryFar = coarse.schedule(&strategy, hours(24 * 60));
+    tf.assert_true(coarse.advanceTo(t0 + hours(24 * 60) - seconds(1)) == 0, "60-day timer should not fire early");
+    tf.assert_true(coarse.advanceTo(t0 + hours(24 * 60)) == 1 && strategy.firedIds.back() == veryFar,
+                   "60-day timer should fire on time");
+    
+    // Callbacks may reschedule (periodic) and cancel other timers
+    strategy.firedIds.clear();
+    auto now = timers.now();
+    strategy.reschedules = 3;
+    timers.schedule(&strategy, milliseconds(10));
+    TimerId victim = timers.schedule(&strategy, milliseconds(15));
+    strategy.cancelOnFire = victim;
+    tf.assert_true(timers.advanceTo(now + milliseconds(100)) == 4, "Periodic timer should fire 4 times");
+    tf.assert_true(timers.pending() == 0, "Cancelled victim should never fire");
+    
+    // Many outstanding timers with mixed cancellation
+    std::vector<TimerId> ids;
+    now = timers.now();
+    for (int i = 0; i < 200000; i++) {
+        ids.push_back(timers.schedule(&strategy, milliseconds(1 + (i * 7919) % 100000)));
+    }
+    for (size_t i = 0; i < ids.size(); i += 2) {
+        timers.cancel(ids[i]);
+    }
+    strategy.firedAt.clear();
+    size_t fired = timers.advanceTo(now + seconds(100));
+    bool ordered = true;
+    for (size_t i = 1; i < strategy.firedAt.size(); i++) {
+        ordered = ordered && strategy.firedAt[i - 1] <= strategy.firedAt[i];
+    }
+    tf.assert_true(fired == 100000 && timers.pending() == 0, "Exactly the uncancelled half should fire");
+    tf.assert_true(ordered, "Mass-scheduled timers should fire in time order");
+    
+    // nextDue bounds how long a live loop may wait for data
+    TimerService idle;
+    bool threw = false;
+    try {
+        idle.advanceTo(t0);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    tf.assert_true(threw, "Advancing a wheel that was never started should throw");
+    idle.start(t0);
+    tf.assert_true(idle.nextDue() == TimerService::Clock::time_point::max(), "Idle wheel should have nothing due");
+    idle.schedule(&strategy, milliseconds(40));
+    tf.assert_true(idle.nextDue() <= t0 + milliseconds(40) && idle.nextDue() > t0, "nextDue should never be late");
+    idle.advanceTo(idle.nextDue());
+    
+    // A quiet feed keeps running; waiting on it is bounded by the caller
+    ManualDataFeed quiet;
+    quiet.start();
+    auto waitStart = std::chrono::steady_clock::now();
+    MarketData slot;
+    tf.assert_true(quiet.getNextBatch(&slot, 1, milliseconds(5)) == 0 && quiet.isRunning(),
+                   "Quiet feed should time out without ending");
+    tf.assert_true(std::chrono::steady_clock::now() - waitStart < milliseconds(90), "Wait should honour maxWait");
+    MarketData tick("AAPL", 1.0, 1.0, 1.0, 1);
+    quiet.addData(tick);
+    TimerService::Clock::time_point peeked;
+    tf.assert_true(quiet.peekTimestamp(peeked) && peeked == tick.timestamp, "Peek should see the queued tick");
+    tf.assert_true(quiet.getNextBatch(&slot, 1) == 1, "Peek should leave the tick queued");
+    quiet.stop();
+    
+    // Backtest loop as in main(): timers scheduled from onMarketData count from
+    // the tick's timestamp, even when the whole session arrives in one batch
+    class DataTimeStrategy : public TimerRecordingStrategy {
+    public:
+        std::vector<TimerService::Clock::time_point> seen;
+        size_t seenAtFire = 0;
+        void onMarketData(const MarketData& data) override {
+            seen.push_back(data.timestamp);
+            if (seen.size() == 2) timers->schedule(this, seconds(5));
+        }
+        void onTimer(TimerId timerId) override {
+            seenAtFire = seen.size();
+            TimerRecordingStrategy::onTimer(timerId);
+        }
+    };
+    ManualDataFeed session;
+    session.start();
+    Price px = Price::fromDouble("AAPL", 150.0);
+    for (int i = 0; i < 4; i++) {
+        session.addData(MarketData("AAPL", px, px, px, 100, t0 + seconds(10 * i)));
+    }
+    IndicatorRegistry sessionIndicators;
+    DataTimeStrategy dataTime;
+    Strategy* sessionStrategies[] = {&dataTime};
+    TimerService sessionTimers;
+    dataTime.setTimerService(&sessionTimers);
+    TimerService::Clock::time_point first;
+    tf.assert_true(session.peekTimestamp(first), "Session should have a first tick");
+    sessionTimers.start(first);
+    std::vector<MarketData> sessionBatch(64);
+    size_t sessionCount = session.getNextBatch(sessionBatch.data(), sessionBatch.size());
+    dispatchTicksOnDataTime(sessionTimers, &sessionIndicators, sessionStrategies, 1, sessionBatch.data(), sessionCount);
+    tf.assert_true(dataTime.firedAt.size() == 1 && dataTime.firedAt[0] == t0 + seconds(15),
+                   "Timer scheduled 5s after the 10s tick should fire at data time 15s");
+    tf.assert_true(dataTime.seenAtFire == 2, "Timer should fire between the 10s and 20s ticks");
+    session.stop();
+}
+
+void testItchDecoder(TestFramework& tf) {
+    std::cout << "\n🧪 Testing ItchDecoder..." << std::endl;
+    
+    std::vector<uint8_t> stream;
+    itch::Encoder encoder(stream);
+    encoder.directory(1000, 0, "AAPL");
+    encoder.directory(1000, 1, "MSFT");
+    encoder.addOrder(2000, 0, 1, 'B', 100, 15000);   // Bid 150.00, held: no trade price yet
+    encoder.addOrder(2001, 0, 2, 'S', 200, 15010);   // Ask 150.10, held
+    encoder.addOrder(2002, 0, 3, 'B', 300, 14990);   // Behind the touch
+    encoder.addOrder(2003, 0, 4, 'B', 50, 15000);    // Adds size at the touch
+    encoder.executeOrder(2004, 0, 1, 100);           // First trade price releases the book
+    encoder.deleteOrder(2005, 0, 4);                 // Bid drops to 149.90
+    encoder.modifyOrder(2006, 0, 2, 200, 15005);     // Ask improves to 150.05
+    encoder.cancelShares(2007, 0, 3, 300);           // Bid side now empty
+    encoder.trade(2008, 0, 15003, 500);              // Trade only: no emission
+    encoder.quote(2009, 1, 30000, 10, 30002, 20);    // Quote-driven MSFT, held
+    encoder.trade(2010, 1, 30001, 100);              // Releases MSFT
+    encoder.quote(2011, 1, 30000, 15, 30002, 20);    // Size change only: no emission
+    
+    ItchDecoder decoder;
+    std::vector<MarketData> ticks;
+    size_t used = decoder.decode(stream.data(), stream.size(), ticks);
+    tf.assert_true(used == stream.size(), "Decoder should consume the whole stream");
+    tf.assert_true(decoder.messagesDecoded() == 14, "Decoder should count 14 messages");
+    tf.assert_true(ticks.size() == 5, "Only BBO changes after the first trade should be emitted");
+    if (ticks.size() == 5) {
+        tf.assert_true(ticks[0].bid == Price(15000) && ticks[0].ask == Price(15010) &&
+                       ticks[0].last == Price(15000) && ticks[0].volume == 100,
+                       "First execution should release the book with its trade price");
+        tf.assert_true(ticks[1].bid == Price(14990), "Delete at the touch should expose the next level");
+        tf.assert_true(ticks[2].ask == Price(15005), "Modify should move the ask");
+        tf.assert_true(ticks[3].bid == Price() && ticks[3].symbol == "AAPL", "Emptied bid side reports zero");
+        tf.assert_true(ticks[4].symbol == "MSFT" && ticks[4].bid == Price(30000) && ticks[4].ask == Price(30002) &&
+                       ticks[4].last == Price(30001), "Quote-driven symbol should emit once it has traded");
+        tf.assert_true(ticks[4].timestamp.time_since_epoch() == std::chrono::nanoseconds(2010),
+                       "Timestamp should come from the message");
+    }
+    bool allPriced = true;
+    for (const auto& tick : ticks) {
+        allPriced = allPriced && tick.last != Price();
+    }
+    tf.assert_true(allPriced, "No tick should carry a zero last price");
+    tf.assert_true(decoder.liveOrders() == 1, "Only the modified ask should still rest");
+    
+    // References late in a session are far beyond any flat table
+    std::vector<uint8_t> lateSession;
+    itch::Encoder lateEncoder(lateSession);
+    lateEncoder.directory(1000, 0, "AAPL");
+    const uint64_t firstRef = uint64_t(1) << 40;
+    for (uint64_t i = 0; i < 5000; i++) {
+        lateEncoder.addOrder(2000 + i, 0, firstRef + i * 977, i % 2 ? 'S' : 'B', 100,
+                             i % 2 ? 15010 + i % 7 : 14990 - i % 7);
+    }
+    lateEncoder.executeOrder(8000, 0, firstRef, 100);
+    for (uint64_t i = 1; i < 5000; i++) {
+        lateEncoder.deleteOrder(9000 + i, 0, firstRef + i * 977);
+    }
+    ItchDecoder lateDecoder;
+    std::vector<MarketData> lateTicks;
+    lateDecoder.decode(lateSession.data(), lateSession.size(), lateTicks);
+    tf.assert_true(lateDecoder.liveOrders() == 0, "Large references should be tracked and released");
+    tf.assert_true(!lateTicks.empty() && lateTicks.back().bid == Price() && lateTicks.back().ask == Price(),
+                   "Book should be empty once every late order is gone");
+    
+    // Feeding the same stream in awkward pieces must give identical output
+    std::vector<uint8_t> capture = itch::generateCapture({"AAPL", "MSFT", "GOOGL", "SPY"}, 50000, 3);
+    ItchDecoder whole;
+    std::vector<MarketData> expected;
+    whole.decode(capture.data(), capture.size(), expected);
+    
+    ItchDecoder chunked;
+    std::vector<MarketData> actual;
+    std::vector<uint8_t> pending;
+    for (size_t pos = 0; pos < capture.size(); pos += 997) {
+        size_t end = std::min(capture.size(), pos + 997);
+        pending.insert(pending.end(), capture.begin() + pos, capture.begin() + end);
+        size_t consumed = chunked.decode(pending.data(), pending.size(), actual);
+        pending.erase(pending.begin(), pending.begin() + consumed);
+    }
+    bool same = pending.empty() && !expected.empty() && actual.size() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); i++) {
+        same = actual[i].symbol == expected[i].symbol && actual[i].bid == expected[i].bid &&
+               actual[i].ask == expected[i].ask && actual[i].timestamp == expected[i].timestamp;
+    }
+    tf.assert_true(whole.messagesDecoded() == 50000, "Generated capture should hold 50000 messages");
+    tf.assert_true(same, "Chunked decoding should match decoding in one pass");
+    
+    // File replay through the DataFeed interface, filtered to one symbol
+    std::string path = "test_capture.itch";
+    itch::writeCapture(path, capture);
+    ItchFileFeed feed(path);
+    feed.subscribe("GOOGL");
+    feed.start();
+    std::vector<MarketData> batch(256);
+    size_t received = 0;
+    bool onlyGoogl = true;
+    while (size_t count = feed.getNextBatch(batch.data(), batch.size())) {
+        for (size_t i = 0; i < count; i++) {
+            onlyGoogl = onlyGoogl && batch[i].symbol == "GOOGL";
+        }
+        received += count;
+    }
+    feed.stop();
+    
+    // Stopping mid-replay ends the session for consumers
+    ItchFileFeed early(path);
+    early.start();
+    early.getNextBatch(batch.data(), 1);
+    early.stop();
+    tf.assert_true(!early.isRunning(), "Feed stopped mid-replay should report not running");
+    std::remove(path.c_str());
+    size_t googlTicks = std::count_if(expected.begin(), expected.end(),
+                                      [](const MarketData& d) { return d.symbol == "GOOGL"; });
+    tf.assert_true(received == googlTicks && received > 0, "File feed should replay every GOOGL BBO change");
+    tf.assert_true(onlyGoogl, "File feed should only emit subscribed symbols");
+}
+
+void testOrderGateway(TestFramework& tf) {
+    std::cout << "\n🧪 Testing OrderGateway..." << std::endl;
+    
+    BrokerSimulator broker;
+    broker.start();
+    OrderManager orderManager;
+    OrderGateway gateway(orderManager, broker.port());
+    gateway.start();
+    orderManager.setGateway(&gateway);
+    
+    int buyId = orderManager.submitOrder("AAPL", OrderType::BUY, 100, 150.0);
+    int sellId = orderManager.submitOrder("MSFT", OrderType::SELL, 50, 300.25);
+    int badId = orderManager.submitOrder("AAPL", OrderType::BUY, 0, 150.0);
+    tf.assert_true(gateway.waitForCompletion(std::chrono::seconds(5)), "Broker should answer every order");
+    tf.assert_true(orderManager.getOrderStatus(buyId) == OrderStatus::FILLED, "Buy order should be filled");
+    tf.assert_true(orderManager.getOrderStatus(sellId) == OrderStatus::FILLED, "Sell order should be filled");
+    tf.assert_true(orderManager.getOrderStatus(badId) == OrderStatus::REJECTED, "Zero quantity order should be rejected");
+    tf.assert_true(gateway.ordersAcknowledged() == 2, "Accepted orders should be acknowledged");
+    
+    // Several strategy threads submitting at once
+    const int threadCount = 4;
+    const int ordersPerThread = 2000;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<int>> ids(threadCount);
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < ordersPerThread; i++) {
+                ids[t].push_back(orderManager.submitOrder("SPY", i % 2 ? OrderType::SELL : OrderType::BUY,
+                                                          1 + i % 100, 400.0 + (i % 10) * 0.01));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    tf.assert_true(gateway.waitForCompletion(std::chrono::seconds(5)), "Concurrent orders should all complete");
+    
+    int filled = 0;
+    for (const auto& threadIds : ids) {
+        for (int id : threadIds) {
+            filled += orderManager.getOrderStatus(id) == OrderStatus::FILLED;
+        }
+    }
+    tf.assert_true(filled == threadCount * ordersPerThread, "Every concurrent order should be filled");
+    tf.assert_true(broker.ordersReceived() == 3 + threadCount * ordersPerThread, "Broker should see each order once");
+    
+    int longId = orderManager.submitOrder("TOOLONGSYM", OrderType::BUY, 100, 10.0);
+    tf.assert_true(orderManager.getOrderStatus(longId) == OrderStatus::REJECTED,
+                   "Symbols that do not fit the wire format should be rejected, not left pending");
+    tf.assert_true(gateway.waitForCompletion(std::chrono::seconds(5)), "A refused order should not count as in flight");
+    
+    gateway.stop();
+    int stoppedId = orderManager.submitOrder("AAPL", OrderType::BUY, 100, 150.0);
+    tf.assert_true(orderManager.getOrderStatus(stoppedId) == OrderStatus::REJECTED,
+                   "Orders sent after the gateway stopped should be rejected");
+    broker.stop();
+}
+
 int main() {
     std::cout << "🚀 Starting Algorithmic Trading System Tests..." << std::endl;
     std::cout << std::string(60, '=') << std::endl;
@@ -235,6 +958,13 @@ int main() {
         testRiskManager(tf);
         testOrderManager(tf);
         testMovingAverageCrossover(tf);
+        testTickCodec(tf);
+        testIndicatorRegistry(tf);
+        testFixedPointPrice(tf);
+        testBatchDelivery(tf);
+        testTimerService(tf);
+        testItchDecoder(tf);
+        testOrderGateway(tf);
         
     } catch (const std::exception& e) {
         std::cout << "❌ Test failed with exception: " << e.what() << std::endl;
@@ -0,0 +1,34 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/itch_feed.h"
+
+// Writes a synthetic binary feed capture for offline testing and benchmarks.
+// Usage: GenerateItchCapture <output file> [message count] [SYM1,SYM2,...] [seed]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <output file> [message count] [SYM1,SYM2,...] [seed]" << std::endl;
+        return 1;
+    }
+    
+    try {
+        std::string output = argv[1];
+        size_t messageCount = argc > 2 ? std::stoul(argv[2]) : 10000000;
+        std::vector<std::string> symbols;
+        std::stringstream list(argc > 3 ? argv[3] : "AAPL,GOOGL,MSFT,AMZN,NVDA,SPY");
+        std::string symbol;
+        while (std::getline(list, symbol, ',')) {
+            symbols.push_back(symbol);
+        }
+        uint64_t seed = argc > 4 ? std::stoull(argv[4]) : 1;
+        
+        std::vector<uint8_t> capture = itch::generateCapture(symbols, messageCount, seed);
+        itch::writeCapture(output, capture);
+        std::cout << "Wrote " << messageCount << " messages (" << capture.size() << " bytes) to " << output << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}